@@ -0,0 +1,188 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : window integrals and alpha peak positions, widths and tails of
+ *               merged spectra and fit outputs
+ * Compilation : g++ -O3 -std=c++1y $(root-config --cflags) AlphaPeakFinder.cxx $(root-config --libs) -o AlphaPeakFinder
+*/
+
+
+// c/c++
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <regex>
+#include <chrono>
+
+// root cern
+#include "TFile.h"
+#include "TH1D.h"
+#include "TKey.h"
+#include "TDirectory.h"
+
+// spectra-utils
+#include "OptionParser.h"
+#include "PeakIntegrals.h"
+
+using namespace std;
+
+// energy window given in the window file
+struct Window
+{
+    string label;
+    double elo, ehi;
+};
+
+// spectrum loaded from file, keeps only the prefix sums
+struct Spectrum
+{
+    string    name;
+    PrefixSum sums;
+};
+
+OptionParser MakeParser();
+int Run( const Options & opts );
+void LoadSpectra( TDirectory & dir, string path, const regex & select, vector<Spectrum> & spectra );
+bool ReadWindows( string filename, vector<Window> & windows );
+
+int main( int argc, char* argv[] )
+{
+    // get command line arguments, one job per parameter set
+    OptionParser parser = MakeParser();
+    vector<Options> jobs;
+    int status = parser.ParseCommandLine( argc, argv, jobs );
+    if( status != 0 ) return status == OptionParser::kDone ? 0 : 1;
+
+    return RunJobs( jobs, Run );
+}
+
+int Run( const Options & opts )
+{
+    regex select( opts.Get("--histo") );
+
+    vector<Window> windows;
+    if( opts.Has("--windows") && !ReadWindows( opts.Get("--windows"), windows ) ) return 1;
+    if( windows.empty() && !opts.Has("--peaks") ) { cout << "Nothing to do, give --windows and/or --peaks" << endl; return 1; }
+
+    // build prefix sums once per histogram
+    auto start = chrono::steady_clock::now();
+    vector<Spectrum> spectra;
+    for( auto & input : opts.Positional() )
+    {
+        TFile file( input.c_str(), "READ" );
+        if( !file.IsOpen() ) { cout << "File not Found: " << input << endl; return 1; }
+        LoadSpectra( file, input + ":", select, spectra );
+        file.Close();
+    }
+    auto loaded = chrono::steady_clock::now();
+
+    // write tables to output file or stdout
+    ofstream ofout;
+    if( opts.Has("--output") )
+    {
+        ofout.open( opts.Get("--output") );
+        if( !ofout.is_open() ) { cout << "Cannot open output: " << opts.Get("--output") << endl; return 1; }
+    }
+    ostream & out = opts.Has("--output") ? ofout : cout;
+
+    // window integrals, O(1) per query
+    if( !windows.empty() )
+    {
+        out << "spectrum";
+        for( auto & w : windows ) out << "\t" << w.label;
+        out << "\n";
+        for( auto & s : spectra )
+        {
+            out << s.name;
+            for( auto & w : windows ) out << "\t" << s.sums.Integral( w.elo, w.ehi );
+            out << "\n";
+        }
+    }
+
+    // alpha peaks
+    if( opts.Has("--peaks") )
+    {
+        double below = opts.GetDouble("--search-below"), above = opts.GetDouble("--search-above");
+        double tailwindow = opts.GetDouble("--tail-window");
+
+        if( !windows.empty() ) out << "\n";
+        out << "spectrum\tline\tposition\tshift\tfwhm\tcounts\ttail_fraction\n";
+        for( auto & s : spectra )
+            for( auto & peak : FindAlphaPeaks( s.sums, below, above, tailwindow ) )
+                if( peak.found )
+                    out << s.name << "\t" << peak.line << "\t" << peak.position << "\t" << peak.shift << "\t" << peak.fwhm << "\t"
+                        << peak.counts << "\t" << peak.tail << "\n";
+    }
+
+    auto stop = chrono::steady_clock::now();
+    cout << spectra.size() << " spectra loaded in " << chrono::duration<double,milli>( loaded - start ).count()
+         << " ms, analysed in " << chrono::duration<double,milli>( stop - loaded ).count() << " ms" << endl;
+
+    return 0;
+}
+
+// prefix sums of all TH1D in dir and its subdirectories whose path matches select
+void LoadSpectra( TDirectory & dir, string path, const regex & select, vector<Spectrum> & spectra )
+{
+    TIter next( dir.GetListOfKeys() );
+    TKey * key;
+    while( (key = (TKey*)next()) )
+    {
+        string name  = key->GetName();
+        string cname = key->GetClassName();
+        if( cname == "TDirectoryFile" )
+        {
+            TDirectory * subdir = dir.GetDirectory( name.c_str() );
+            if( subdir ) LoadSpectra( *subdir, path + name + "/", select, spectra );
+            continue;
+        }
+        if( cname != "TH1D" || !regex_search( path + name, select ) ) continue;
+
+        TH1D * h = (TH1D*)dir.Get( name.c_str() );
+        if( !h ) continue;
+        int nbins = h->GetNbinsX();
+        vector<double> edges( nbins+1 );
+        for( int b = 1; b <= nbins+1; b++ ) edges[b-1] = h->GetXaxis()->GetBinLowEdge(b);
+        spectra.push_back( { path + name, PrefixSum( h->GetArray()+1, edges.data(), nbins ) } );
+    }
+}
+
+// one window per line: <elo> <ehi> [label], # starts a comment
+bool ReadWindows( string filename, vector<Window> & windows )
+{
+    ifstream ifwindows( filename );
+    if( !ifwindows.is_open() ) { cout << "Window file not Found: " << filename << endl; return false; }
+
+    string line;
+    while( getline( ifwindows, line ) )
+    {
+        auto hash = line.find('#');
+        if( hash != string::npos ) line.erase(hash);
+
+        istringstream tokens( line );
+        Window w;
+        if( !( tokens >> w.elo ) ) continue;
+        if( !( tokens >> w.ehi ) ) { cout << "Window needs two energies: " << line << endl; return false; }
+        if( !( tokens >> w.label ) ) w.label = to_string((int)w.elo) + "-" + to_string((int)w.ehi);
+        windows.push_back( w );
+    }
+    return true;
+}
+
+OptionParser MakeParser()
+{
+    OptionParser parser( "AlphaPeakFinder", "Window integrals and alpha peaks (Ra226, Po210, Rn222, Po218, Po214) of spectra" );
+    parser.AddExample( "--windows windows.txt --peaks combined-Po210-pPlus.root combined-Ra226-pPlus.root" );
+    parser.AddExample( "--histo 'components/.*' --peaks fit-result.root" );
+    parser.AddPositional( "<files>", "root files, all TH1D (also in subdirectories) are loaded", 1 );
+    parser.AddOption( "--histo",        "",   OptionParser::kString, "<regex>",  "select histograms by <directory>/<name>", "." );
+    parser.AddOption( "--windows",      "-w", OptionParser::kString, "<file>",   "energy windows, lines <elo> <ehi> [label]" );
+    parser.AddFlag  ( "--peaks",        "-p", "find the alpha peaks of every spectrum" );
+    parser.AddOption( "--search-below", "",   OptionParser::kDouble, "<keV>",    "largest dead layer shift of the peaks below the lines", "300" );
+    parser.AddOption( "--search-above", "",   OptionParser::kDouble, "<keV>",    "tolerance of a peak around its shifted line", "50" );
+    parser.AddOption( "--tail-window",  "",   OptionParser::kDouble, "<keV>",    "low energy tail window below the peak", "500" );
+    parser.AddOption( "--output",       "-o", OptionParser::kString, "<file>",   "write tables to file instead of stdout" );
+    return parser;
+}
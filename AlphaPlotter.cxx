@@ -11,6 +11,8 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <sstream>
+#include <chrono>
 
 // root
 #include "TROOT.h"
@@ -22,10 +24,17 @@
 #include "TLine.h"
 #include "TStyle.h"
 
+// spectra-utils
+#include "OptionParser.h"
+#include "OutputFile.h"
+#include "DeadLayerInterpolator.h"
+
 using namespace std;
 
-// usage
-void Usage();
+// option schema
+OptionParser MakeParser();
+// plot one input file
+int Run( const Options & opts );
 
 int main( int argc, char * argv[] )
 {
@@ -34,69 +43,43 @@ int main( int argc, char * argv[] )
     gStyle->SetOptTitle(0);
     gStyle->SetLineScalePS(1);
 
-    // get command line arguments
-    vector<string> args;
-    for ( int i = 0; i < argc; ++i ) args.push_back( argv[i] );
+    // get command line arguments, one job per parameter set
+    OptionParser parser = MakeParser();
+    vector<Options> jobs;
+    int status = parser.ParseCommandLine( argc, argv, jobs );
+    if( status != 0 ) return status == OptionParser::kDone ? 0 : 1;
 
-    // user requested help or made input error
-    if ( argc < 2 ) { Usage(); return 1; }
-    else if ( find(args.begin(), args.end(), "--help") != args.end() ||
-              find(args.begin(), args.end(), "-h")     != args.end() ) { Usage(); return 1; }
+    return RunJobs( jobs, Run );
+}
 
+int Run( const Options & opts )
+{
     // check OPTIONS
-    // get input file name
-    string input_filename;
-    auto result = find( args.begin(), args.end(), "--input" );
-    if ( result != args.end() ) input_filename = *(result+1);
-    else { Usage(); return 1; }
-
-    // inset flag (optional)
-    string inset_pos = "none";
-    result = find( args.begin(), args.end(), "--inset" );
-    if ( result != args.end() ) inset_pos = *(result+1);
-    // xmin main pad (optional)
-    double xmin = 0.;
-    result = find( args.begin(), args.end(), "--x-min" );
-    if ( result != args.end() ) xmin = stod(*(result+1));
-    result = find( args.begin(), args.end(), "-x" );
-    if ( result != args.end() ) xmin = stod(*(result+1));
-    // xmax main pad (optional)
-    double xmax = 8000.;
-    result = find( args.begin(), args.end(), "--x-max" );
-    if ( result != args.end() ) xmax = stod(*(result+1));
-    result = find( args.begin(), args.end(), "-X" );
-    if ( result != args.end() ) xmax = stod(*(result+1));
-    // ymin main pad (optional)
-    double ymin = 1.e3;
-    result = find( args.begin(), args.end(), "--y-min" );
-    if ( result != args.end() ) ymin = stod(*(result+1));
-    result = find( args.begin(), args.end(), "-y" );
-    if ( result != args.end() ) ymin = stod(*(result+1));
-    // ymax main pad (optional)
-    double ymax = 5.e8;
-    result = find( args.begin(), args.end(), "--y-max" );
-    if ( result != args.end() ) ymax = stod(*(result+1));
-    result = find( args.begin(), args.end(), "-Y" );
-    if ( result != args.end() ) ymax = stod(*(result+1));
-    // xmin inset pad (optional)
-    double xmin_inset = 0.;
-    result = find( args.begin(), args.end(), "--x-min-inset" );
-    if ( result != args.end() ) xmin_inset = stod(*(result+1));
-    result = find( args.begin(), args.end(), "-xi" );
-    if ( result != args.end() ) xmin_inset = stod(*(result+1));
-    // xmax inset pad (optional)
-    double xmax_inset = 8000.;
-    result = find( args.begin(), args.end(), "--x-max-inset" );
-    if ( result != args.end() ) xmax_inset = stod(*(result+1));
-    result = find( args.begin(), args.end(), "-Xi" );
-    if ( result != args.end() ) xmax_inset = stod(*(result+1));
-
+    string input_filename = opts.Get("--input");
+    string inset_pos      = opts.Get("--inset");
+    double xmin           = opts.GetDouble("--x-min");
+    double xmax           = opts.GetDouble("--x-max");
+    double ymin           = opts.GetDouble("--y-min");
+    double ymax           = opts.GetDouble("--y-max");
+    double xmin_inset     = opts.GetDouble("--x-min-inset");
+    double xmax_inset     = opts.GetDouble("--x-max-inset");
+    int compression;
+    if( !GetCompression( opts, compression ) ) return 1;
+
+    // interpolated dead layers (optional)
+    vector<double> dl_interp;
+    stringstream sdl( opts.Get("--dead-layer") );
+    string sval;
+    while( getline( sdl, sval, ',' ) ) dl_interp.push_back( stod(sval) );
+    DeadLayerInterpolator::Mode mode = DeadLayerInterpolator::kMorph;
+    if(      opts.Get("--interpolation") == "linear" ) mode = DeadLayerInterpolator::kLinear;
+    else if( opts.Get("--interpolation") != "morph"  ) { cout << "Unknown interpolation: " << opts.Get("--interpolation") << endl; return 1; }
 
     string isotope = input_filename.substr(4,5);
     string loc = input_filename.substr(10,1);
     string location = "unknown";
-    if( loc == 'p' ) location = "pPlus";
-    else if( loc == 'L' ) location = "LAr";
+    if( loc == "p" ) location = "pPlus";
+    else if( loc == "L" ) location = "LAr";
     string output_filename = "plot-"; output_filename += isotope; output_filename += location; output_filename += ".root";
     string outpdf = "plot-"; outpdf += isotope; outpdf += location; outpdf += ".pdf";
 
@@ -106,6 +89,7 @@ int main( int argc, char * argv[] )
 
     // open input file
     TFile infile( input_filename.c_str() );
+    if( !infile.IsOpen() ) { cout << "File not Found: " << input_filename << endl; return 1; }
 
     // load histograms in vector
     vector<TH1D*> v_histos;
@@ -113,7 +97,72 @@ int main( int argc, char * argv[] )
     for( int dl = 0; dl <= 1000; dl+=100 )
     {
         string histname = "hist_dl"; histname += to_string(dl); histname += "nm";
-        v_histos.push_back( (TH1D*) infile.Get(histname.c_str()) );
+        TH1D * h = (TH1D*) infile.Get(histname.c_str());
+        if( !h ) { cout << "Histogram not Found: " << histname << endl; return 1; }
+        v_histos.push_back( h );
+    }
+
+    // interpolate between the simulated dead layers
+    vector<TH1D*> v_interp;
+    if( !dl_interp.empty() )
+    {
+        TH1D * h0 = v_histos.front();
+        int nbins = h0->GetNbinsX();
+        double xlo = h0->GetXaxis()->GetXmin(), xhi = h0->GetXaxis()->GetXmax();
+
+        // the interpolator reads nbins fixed width bins of every simulated point
+        for( auto h : v_histos )
+        {
+            if( h->GetNbinsX() != nbins || h->GetXaxis()->GetXmin() != xlo || h->GetXaxis()->GetXmax() != xhi ||
+                h->GetXaxis()->GetXbins()->GetSize() > 0 )
+            {
+                cout << "Cannot interpolate: " << h->GetName() << " has not the fixed binning of " << h0->GetName() << endl;
+                return 1;
+            }
+        }
+
+        DeadLayerInterpolator interpolator( nbins, xlo, xhi );
+        for( size_t p = 0; p < v_histos.size(); p++ ) interpolator.AddPoint( p*100, v_histos[p]->GetArray()+1 );
+
+        // entries and mean weight per entry (sum of squared weights / integral) of
+        // the simulated points, interpolated linearly for the errors of the spectra
+        vector<double> v_entries, v_weight;
+        for( auto h : v_histos )
+        {
+            double integral = h->Integral();
+            double sumw2 = 0.;
+            if( h->GetSumw2N() ) for( int b = 1; b <= nbins; b++ ) sumw2 += h->GetSumw2()->GetArray()[b];
+            v_entries.push_back( h->GetEntries() );
+            v_weight.push_back( h->GetSumw2N() && integral > 0. ? sumw2 / integral : 1. );
+        }
+
+        auto start = chrono::steady_clock::now();
+        for( auto dl : dl_interp )
+        {
+            if( dl < interpolator.GetMinDeadLayer() || dl > interpolator.GetMaxDeadLayer() )
+            {
+                cout << "Dead layer " << dl << "nm outside of simulated range" << endl;
+                return 1;
+            }
+            string histname = "hist_dl"; histname += to_string((int)dl); histname += "nm_interp";
+            TH1D * h = (TH1D*) h0->Clone( histname.c_str() );
+            h->Reset();
+            interpolator.Evaluate( dl, mode, h->GetArray()+1 );
+
+            // poisson errors of the interpolated contents scaled by the mean weight
+            size_t p = min( (size_t)( dl / 100 ), v_histos.size()-2 );
+            double t = dl / 100 - p;
+            double weight = v_weight[p] + t * ( v_weight[p+1] - v_weight[p] );
+            if( h->GetSumw2N() )
+            {
+                double * sumw2 = h->GetSumw2()->GetArray();
+                for( int b = 1; b <= nbins; b++ ) sumw2[b] = weight * max( h->GetBinContent(b), 0. );
+            }
+            h->SetEntries( v_entries[p] + t * ( v_entries[p+1] - v_entries[p] ) );
+            v_interp.push_back( h );
+        }
+        double us = chrono::duration<double,micro>( chrono::steady_clock::now() - start ).count();
+        cout << "Interpolated " << v_interp.size() << " spectra, " << us / v_interp.size() << " us per spectrum" << endl;
     }
 
     // create canvas
@@ -177,6 +226,31 @@ int main( int argc, char * argv[] )
         else       h->DrawClone( "histsame" );
     }
 
+    // draw interpolated histograms dashed
+    for( size_t k = 0; k < v_interp.size(); k++ )
+    {
+        TH1D * h = v_interp[k];
+        string dl = to_string((int)dl_interp[k]); dl += "nm";
+        string htitle = isotope; htitle += " " + location + ": dl " + dl + " (interpolated)";
+
+        h->SetLineColor( kBlack );
+        h->SetLineStyle( 2 );
+        h->SetLineWidth( 2 );
+        h->SetTitle( htitle.c_str() );
+        l.AddEntry( h, (dl + " int.").c_str(), "l" );
+
+        if(inset_pos != "none")
+        {
+            inset.cd();
+            h->GetXaxis()->SetRangeUser(xmin_inset,xmax_inset);
+            h->DrawClone( "histsame" );
+        }
+
+        mainpad.cd();
+        h->GetXaxis()->SetRangeUser(xmin,xmax);
+        h->DrawClone( "histsame" );
+    }
+
     mainpad.cd();
 
     // draw inset limits in main pad
@@ -198,8 +272,10 @@ int main( int argc, char * argv[] )
 
     // open output file
     TFile outfile( output_filename.c_str(), "RECREATE" );
+    SetCompression( outfile, compression );
     c.Write();
     for( auto h : v_histos ) h->Write();
+    for( auto h : v_interp ) h->Write();
 
     // close root files
     outfile.Close();
@@ -208,24 +284,21 @@ int main( int argc, char * argv[] )
     return 0;
 }
 
-// Prints usage information to shell
-void Usage()
+// Option schema, also prints usage information to shell
+OptionParser MakeParser()
 {
-    cout << "Create plot of 0nm to 100nm p+ surface alpha simulation\n\n";
-    cout << "USAGE   : ./AlphaPlotter [OPTIONS]\n\n";
-    cout << "EXAMPLE : ./AlphaPlotter --inset top -x 0 -X 7000 -y 0.1 -Y 1e3 -xi 4800 -Xi 5600 --input default.root\n\n";
-    cout << "OPTIONS :\n\n";
-    cout << "    required :  --input <filename>    : input txt file containing a list of\n"
-         << "                                        result files and binning \n";
-    cout << "    optional :  --inset <position>    : draw inset with all histograms which can be\n" <<
-                                                     "zoomed to a different region for evidencing features\n" <<
-                                                     "(none (default), top, bottom)";
-    cout << "                --x-min       -x      : x-min for main pad\n";
-    cout << "                --x-max       -X      : x-max for main pad\n";
-    cout << "                --y-min       -y      : y-min for main pad\n";
-    cout << "                --y-max       -Y      : y-max for main pad\n";
-    cout << "                --x-min-inset -xi     : x-min for inset pad\n";
-    cout << "                --x-max-inset -Xi     : x-max for inset pad\n";
-    return;
+    OptionParser parser( "AlphaPlotter", "Create plot of 0nm to 1000nm p+ surface alpha simulation" );
+    parser.AddExample( "--inset top -x 0 -X 7000 -y 0.1 -Y 1e3 -xi 4800 -Xi 5600 --input default.root" );
+    parser.AddOption( "--input",       "",    OptionParser::kString, "<filename>", "input root file with hist_dl<x>nm histograms", "", true );
+    parser.AddOption( "--inset",       "",    OptionParser::kString, "<position>", "draw inset with all histograms (none, top, bottom)", "none" );
+    parser.AddOption( "--x-min",       "-x",  OptionParser::kDouble, "<double>",   "x-min for main pad",  "0" );
+    parser.AddOption( "--x-max",       "-X",  OptionParser::kDouble, "<double>",   "x-max for main pad",  "8000" );
+    parser.AddOption( "--y-min",       "-y",  OptionParser::kDouble, "<double>",   "y-min for main pad",  "1e3" );
+    parser.AddOption( "--y-max",       "-Y",  OptionParser::kDouble, "<double>",   "y-max for main pad",  "5e8" );
+    parser.AddOption( "--x-min-inset", "-xi", OptionParser::kDouble, "<double>",   "x-min for inset pad", "0" );
+    parser.AddOption( "--x-max-inset", "-Xi", OptionParser::kDouble, "<double>",   "x-max for inset pad", "8000" );
+    parser.AddOption( "--dead-layer",    "-dl", OptionParser::kString, "<list>",   "comma separated dead layers (nm) interpolated between the simulated ones" );
+    parser.AddOption( "--interpolation", "",    OptionParser::kString, "<mode>",   "dead layer interpolation (morph, linear)", "morph" );
+    AddCompressionOption( parser );
+    return parser;
 }
-
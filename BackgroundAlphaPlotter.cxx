@@ -11,6 +11,12 @@
 #include <string>
 #include <cstdlib>
 #include <regex>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
 
 // cern root
 #include "TROOT.h"
@@ -27,65 +33,51 @@
 #include "TMath.h"
 #include "Math/ProbFuncMathCore.h"
 
+// spectra-utils
+#include "OptionParser.h"
+#include "OutputFile.h"
+#include "ColumnarWriter.h"
+#include "HistArena.h"
+#include "ParallelIO.h"
+#include "GoodnessOfFit.h"
+
 using namespace std;
 
-void Usage();
+OptionParser MakeParser();
+int Run( const Options & opts );
 string MakeLabel( TString title );
 void rootlogon( string style = "short" );
+bool ReadFitSpectra( TDirectory & dir, HistArena & arena, ArenaHist & sdata, ArenaHist & smc );
+int Scan( const Options & opts );
 
 int main( int argc, char* argv[] )
 {
-    //*******************************************************//
-    // get command line arguments
-    vector<string> args;
-    for ( int i = 0; i < argc; ++i ) args.push_back( argv[i] );
+    // get command line arguments, one job per parameter set
+    OptionParser parser = MakeParser();
+    vector<Options> jobs;
+    int status = parser.ParseCommandLine( argc, argv, jobs );
+    if( status != 0 ) return status == OptionParser::kDone ? 0 : 1;
 
-    // user requested help or made input error
-    if ( argc < 2 ) { Usage(); return 1; }
-    else if ( find(args.begin(), args.end(), "--help") != args.end() ||
-              find(args.begin(), args.end(), "-h")     != args.end() ) { Usage(); return 1; }
+    return RunJobs( jobs, Run );
+}
 
+int Run( const Options & opts )
+{
+    // headless goodness of fit scan over many result files
+    if( opts.Has("--scan") ) return Scan( opts );
+
+    //*******************************************************//
     // check OPTIONS
-    // get input file name
-    string input_filename;
-    auto result = find( args.begin(), args.end(), "--input" );
-    if ( result != args.end() ) input_filename = *(result+1);
-    else { Usage(); return 1; }
-    // output filename
-    string output_filename;
-    result = find( args.begin(), args.end(), "--output" );
-    if ( result != args.end() ) output_filename = *(result+1);
-    else { Usage(); return 1; }
-    // binning
-    int binning = 10;
-    result = find( args.begin(), args.end(), "--binning" );
-    if ( result != args.end() ) binning = stoi( *(result+1) );
-    result = find( args.begin(), args.end(), "-b" );
-    if ( result != args.end() ) binning = stoi( *(result+1) );
-    // colorsequence
-    int colors = 1;
-    result = find( args.begin(), args.end(), "--color-sequence" );
-    if ( result != args.end() ) colors = stoi( *(result+1) );
-    result = find( args.begin(), args.end(), "-cs" );
-    if ( result != args.end() ) colors = stoi( *(result+1) );
-    // xmin xmax ymin ymax
-    double xmin = 3500., xmax = 6000., ymin = 0.1, ymax = 1e3;
-    result = find( args.begin(), args.end(), "-x" );
-    if ( result != args.end() ) xmin = stod( *(result+1) );
-    result = find( args.begin(), args.end(), "-X" );
-    if ( result != args.end() ) xmax = stod( *(result+1) );
-    result = find( args.begin(), args.end(), "-y" );
-    if ( result != args.end() ) ymin = stod( *(result+1) );
-    result = find( args.begin(), args.end(), "-Y" );
-    if ( result != args.end() ) ymax = stod( *(result+1) );
-    // canvas format
-    string style = "long";
-    result = find( args.begin(), args.end(), "--style" );
-    if ( result != args.end() ) style = *(result+1);
-    // draw residuals
-    bool res_flag = false;
-    result = find( args.begin(), args.end(), "-r" );
-    if ( result != args.end() ) res_flag = true;
+    string input_filename  = opts.Get("--input");
+    string output_filename = opts.Get("--output");
+    int binning  = opts.GetInt("--binning");
+    int colors   = opts.GetInt("--color-sequence");
+    double xmin  = opts.GetDouble("-x"), xmax = opts.GetDouble("-X");
+    double ymin  = opts.GetDouble("-y"), ymax = opts.GetDouble("-Y");
+    string style = opts.Get("--style");
+    bool res_flag = opts.Has("-r");
+    int compression;
+    if( !GetCompression( opts, compression ) ) return 1;
     //*******************************************************//
 
     // root style
@@ -94,42 +86,57 @@ int main( int argc, char* argv[] )
 
     // open file
     TFile file( input_filename.c_str(), "READ" );
+    if( !file.IsOpen() ) { cout << "File not Found: " << input_filename << endl; return 1; }
 
-    // get histograms
-    file.cd("results_canvas");
+    // get histograms, only the bins are kept (in arena), the objects stay with the file
+    HistArena arena;
+    ArenaHist sdata, smc;
+    TDirectory * results = file.GetDirectory("results_canvas");
+    if( !results || !ReadFitSpectra( *results, arena, sdata, smc ) ) { cout << "hSum_fine_/hMC_fine_ not Found in " << input_filename << endl; return 1; }
+
+    // get components
+    file.cd("components");
     TIter next(gDirectory->GetListOfKeys());
     TKey * key;
-    TH1D hdata, hmc;
+    vector<ArenaHist> scomp;
+    regex compregex(".*_p[0-9]c[0-9]_fine_.*");
 
-    while( key = (TKey*)next() )
+    while( (key = (TKey*)next()) )
     {
-        TH1D h = *(TH1D*)key->ReadObj();
-        string hname = h.GetName();
+        string hname = key->GetName();
 
         // Find
-        if(     hname.find("hSum_fine_") != string::npos) hdata = *(TH1D*)h.Clone("hdata");
-        else if(hname.find("hMC_fine_")  != string::npos) hmc   = *(TH1D*)h.Clone("hmc");
-   }
+        if( regex_match(hname, compregex) )
+        {
+            string compname = "hcomp_"; compname += to_string(scomp.size());
+            scomp.emplace_back( arena, *(TH1D*)key->ReadObj(), compname );
+        }
+    }
+    file.Close();
 
-    // get components
-    file.cd("components");
-    next = gDirectory->GetListOfKeys();
-    vector<TH1D> hcomp;
-    int c = 0; // component counter
+    // histograms for drawing and writing
+    TH1D hdata, hmc;
+    sdata.CopyTo( hdata );
+    smc.CopyTo( hmc );
+    vector<TH1D> hcomp( scomp.size() );
+    for( size_t c = 0; c < scomp.size(); c++ ) scomp[c].CopyTo( hcomp[c] );
 
-    while( key = (TKey*)next() )
+    // columnar export of the fine binned spectra (optional)
+    if( opts.Has("--columnar") )
     {
-        TH1D h = *(TH1D*)key->ReadObj();
-        string hname = h.GetName();
+        ColumnarWriter writer( opts.Get("--columnar"), compression );
+        if( !writer.IsOpen() ) { cout << "Cannot open columnar output: " << opts.Get("--columnar") << endl; return 1; }
 
-        // Find
-        if( regex_match(hname, regex(".*_p[0-9]c[0-9]_fine_.*")) )
+        SpectrumMeta meta;
+        meta.component = "data"; writer.Fill( hdata, meta );
+        meta.component = "fit";  writer.Fill( hmc,   meta );
+        for( auto & h : hcomp )
         {
-            string compname = "hcomp_"; compname += to_string(c++);
-            hcomp.push_back( *(TH1D*)h.Clone(compname.c_str()) );
+            meta = ParseSpectrumMeta( h.GetTitle() );
+            meta.component = h.GetTitle();
+            writer.Fill( h, meta );
         }
     }
-    file.Close();
 
     // color sequence
     vector<int> sequence1 = { kViolet, kMagenta, kPink, kRed, kOrange, kYellow, kSpring+1, kGreen, kTeal, kCyan, kAzure, kBlue }; // rainbow
@@ -192,16 +199,15 @@ int main( int argc, char* argv[] )
     else          mainpad.SetLogy();
 
     // compute residuals
-    auto res     = dynamic_cast<TH1D*>( hdata.Clone("h_res")       );
-    auto res_b3u = dynamic_cast<TH1D*>( hdata.Clone("h_band3_up")  );
-    auto res_b3l = dynamic_cast<TH1D*>( hdata.Clone("h_band3_low") );
-    auto res_b2u = dynamic_cast<TH1D*>( hdata.Clone("h_band2_up")  );
-    auto res_b2l = dynamic_cast<TH1D*>( hdata.Clone("h_band2_low") );
-    auto res_b1u = dynamic_cast<TH1D*>( hdata.Clone("h_band1_up")  );
-    auto res_b1l = dynamic_cast<TH1D*>( hdata.Clone("h_band1_low") );
+    TH1D res( hdata );
+    TH1D res_b3u( hdata ), res_b3l( hdata ), res_b2u( hdata ), res_b2l( hdata ), res_b1u( hdata ), res_b1l( hdata );
+    res.SetName("h_res");
+    res_b3u.SetName("h_band3_up"); res_b3l.SetName("h_band3_low");
+    res_b2u.SetName("h_band2_up"); res_b2l.SetName("h_band2_low");
+    res_b1u.SetName("h_band1_up"); res_b1l.SetName("h_band1_low");
 
-    int minbin = res->GetXaxis()->FindBin(xmin);
-    int maxbin = res->GetXaxis()->FindBin(xmax);
+    int minbin = res.GetXaxis()->FindBin(xmin);
+    int maxbin = res.GetXaxis()->FindBin(xmax);
 
     for (int b = minbin; b <= maxbin; b++)
     {
@@ -209,35 +215,35 @@ int main( int argc, char* argv[] )
         double m = hmc  .GetBinContent(b);
         double s = TMath::NormQuantile(ROOT::Math::poisson_cdf(d, m));
 
-        res    ->SetBinContent(b, s);
-        res_b3u->SetBinContent(b, +3); res_b3l->SetBinContent(b, -3);
-        res_b2u->SetBinContent(b, +2); res_b2l->SetBinContent(b, -2);
-        res_b1u->SetBinContent(b, +1); res_b1l->SetBinContent(b, -1);
+        res.SetBinContent(b, s);
+        res_b3u.SetBinContent(b, +3); res_b3l.SetBinContent(b, -3);
+        res_b2u.SetBinContent(b, +2); res_b2l.SetBinContent(b, -2);
+        res_b1u.SetBinContent(b, +1); res_b1l.SetBinContent(b, -1);
     }
 
     // set residual colors
     int col3 = kOrange-9, col2 = kYellow-9, col1 = kSpring+1;
-    res_b3u->SetFillColor(col3); res_b3l->SetFillColor(col3);
-    res_b2u->SetFillColor(col2); res_b2l->SetFillColor(col2);
-    res_b1u->SetFillColor(col1); res_b1l->SetFillColor(col1);
-    res_b3u->SetLineColor(col3); res_b3l->SetLineColor(col3);
-    res_b2u->SetLineColor(col2); res_b2l->SetLineColor(col2);
-    res_b1u->SetLineColor(col1); res_b1l->SetLineColor(col1);
+    res_b3u.SetFillColor(col3); res_b3l.SetFillColor(col3);
+    res_b2u.SetFillColor(col2); res_b2l.SetFillColor(col2);
+    res_b1u.SetFillColor(col1); res_b1l.SetFillColor(col1);
+    res_b3u.SetLineColor(col3); res_b3l.SetLineColor(col3);
+    res_b2u.SetLineColor(col2); res_b2l.SetLineColor(col2);
+    res_b1u.SetLineColor(col1); res_b1l.SetLineColor(col1);
 
     // draw residuals
     if(res_flag)
     {
         respad.cd();
         double rl = -3.5, ru = 3.5;
-        res->GetYaxis()->SetRangeUser(rl,ru);
-        res_b3u->GetYaxis()->SetRangeUser(rl,ru); res_b3l->GetYaxis()->SetRangeUser(rl,ru);
-        res_b2u->GetYaxis()->SetRangeUser(rl,ru); res_b2l->GetYaxis()->SetRangeUser(rl,ru);
-        res_b1u->GetYaxis()->SetRangeUser(rl,ru); res_b1l->GetYaxis()->SetRangeUser(rl,ru);
-        res_b3u->GetXaxis()->SetTitleOffset(3.0);
-        res_b3u->GetYaxis()->SetNdivisions(305);
-        res_b3u->Draw("hist");     res_b2u->Draw("histsame"); res_b1u->Draw("histsame");
-        res_b3l->Draw("histsame"); res_b2l->Draw("histsame"); res_b1l->Draw("histsame");
-        res->Draw("histpsame");
+        res.GetYaxis()->SetRangeUser(rl,ru);
+        res_b3u.GetYaxis()->SetRangeUser(rl,ru); res_b3l.GetYaxis()->SetRangeUser(rl,ru);
+        res_b2u.GetYaxis()->SetRangeUser(rl,ru); res_b2l.GetYaxis()->SetRangeUser(rl,ru);
+        res_b1u.GetYaxis()->SetRangeUser(rl,ru); res_b1l.GetYaxis()->SetRangeUser(rl,ru);
+        res_b3u.GetXaxis()->SetTitleOffset(3.0);
+        res_b3u.GetYaxis()->SetNdivisions(305);
+        res_b3u.Draw("hist");     res_b2u.Draw("histsame"); res_b1u.Draw("histsame");
+        res_b3l.Draw("histsame"); res_b2l.Draw("histsame"); res_b1l.Draw("histsame");
+        res.Draw("histpsame");
         respad.RedrawAxis("");
     }
 
@@ -251,32 +257,195 @@ int main( int argc, char* argv[] )
 
     // write to TFile
     TFile outfile( output_filename.c_str(), "RECREATE" );
+    SetCompression( outfile, compression );
     canvas.Write("plot");
     hdata.Write();
     hmc.Write();
-    for( auto h : hcomp ) h.Write();
-    res_b3u->Write(); res_b3l->Write();
-    res_b2u->Write(); res_b2l->Write();
-    res_b1u->Write(); res_b1l->Write();
+    for( auto & h : hcomp ) h.Write();
+    res_b3u.Write(); res_b3l.Write();
+    res_b2u.Write(); res_b2l.Write();
+    res_b1u.Write(); res_b1l.Write();
     outfile.Close();
 
     return 0;
 }
 
-void Usage()
+OptionParser MakeParser()
+{
+    OptionParser parser( "BackgroundAlphaPlotter", "Plot alpha model" );
+    parser.AddOption( "--input",          "",    OptionParser::kString, "<filename>", "input root file", "", true );
+    parser.AddOption( "--output",         "",    OptionParser::kString, "<filename>", "output root file", "", true );
+    parser.AddOption( "--binning",        "-b",  OptionParser::kInt,    "<int>",      "binning of histograms, need to match!", "10" );
+    parser.AddOption( "--color-sequence", "-cs", OptionParser::kInt,    "<int>",      "color sequence (1 rainbow, 2 enrBEGe, 3 enrCoax, 4 natCoax)", "1" );
+    parser.AddOption( "-x",               "",    OptionParser::kDouble, "<double>",   "x-min", "3500" );
+    parser.AddOption( "-X",               "",    OptionParser::kDouble, "<double>",   "x-max", "6000" );
+    parser.AddOption( "-y",               "",    OptionParser::kDouble, "<double>",   "y-min", "0.1" );
+    parser.AddOption( "-Y",               "",    OptionParser::kDouble, "<double>",   "y-max", "1e3" );
+    parser.AddOption( "--style",          "",    OptionParser::kString, "<style>",    "set canvas style (short,long)", "long" );
+    parser.AddFlag  ( "-r",               "",    "draw residuals as normalized quantiles (brazilian plot)" );
+    parser.AddOption( "--columnar",       "",    OptionParser::kString, "<file>",     "also write data, fit and components as columnar tree" );
+    parser.AddFlag  ( "--scan",           "",    "no plots: --input lists fit result files, --output gets their goodness of fit table" );
+    parser.AddOption( "--scan-windows",   "",    OptionParser::kString, "<lo:hi,...>", "scan: energy windows in keV", "3500:5250,5250:5350,3500:8000" );
+    parser.AddOption( "--scan-binnings",  "",    OptionParser::kString, "<n,...>",    "scan: rebin factors (default --binning)" );
+    parser.AddOption( "--scan-sort",      "",    OptionParser::kString, "<key>",      "scan: rank by pvalue, deviance or chi2 (per ndf)", "pvalue" );
+    parser.AddOption( "--npar",           "",    OptionParser::kInt,    "<int>",      "scan: fit parameters subtracted from the degrees of freedom", "0" );
+    AddCompressionOption( parser );
+    AddThreadsOption( parser );
+    return parser;
+}
+
+// data (hSum_fine_) and model (hMC_fine_) of a fit result, false if one is missing
+// or their binnings differ; no other object of dir is read
+bool ReadFitSpectra( TDirectory & dir, HistArena & arena, ArenaHist & sdata, ArenaHist & smc )
 {
-    cout << "Plot alpha model\n\n";
-    cout << "USAGE   : ./BackgroundAlphaPlotter [OPTIONS]\n\n";
-    cout << "OPTIONS :\n\n";
-    cout << "    required :  --input <filename>         : input root file\n";
-    cout << "                --output <filename>        : output root file\n\n";
-    cout << "    optional :  --binning -b <int>         : binning of histograms\n";
-    cout << "                                             need to match!\n";
-    cout << "                --color-sequence -cs <int> : choose a color sequence number (1 rainbow, 2 enrBEGe, 3 enrCoax, 4 natCoax)\n";
-    cout << "                -xXyY <double>             : x/y min/max values e.g. -x 0. -X 8000.\n";
-    cout << "                --style <style>            : set canvas style (short,long)\n";
-    cout << "                -r                         : draw residuals as normalized quantiles (brazilian plot)\n";
-    return;
+    TIter next( dir.GetListOfKeys() );
+    TKey * key;
+    while( (key = (TKey*)next()) )
+    {
+        string hname = key->GetName();
+        if(      hname.find("hSum_fine_") != string::npos ) sdata = ArenaHist( arena, *(TH1D*)key->ReadObj(), "hdata" );
+        else if( hname.find("hMC_fine_")  != string::npos ) smc   = ArenaHist( arena, *(TH1D*)key->ReadObj(), "hmc" );
+    }
+    return sdata.GetNbinsX() > 0 && sdata.SameBinning( smc );
+}
+
+// goodness of fit of one result file in one window and binning
+struct ScanResult
+{
+    string     file;
+    double     elo, ehi;
+    int        binning;
+    FitQuality quality;
+};
+
+// --scan: --input lists the fit result files (one per line), for every file, window and
+// binning the goodness of fit of hMC_fine_ to hSum_fine_ is computed on worker threads;
+// the table in --output is sorted per window and binning, best fit first
+int Scan( const Options & opts )
+{
+    // result files
+    ifstream iflist( opts.Get("--input") );
+    if( !iflist.is_open() ) { cout << "File list not Found: " << opts.Get("--input") << endl; return 1; }
+    vector<string> files;
+    string line;
+    while( getline( iflist, line ) )
+    {
+        size_t first = line.find_first_not_of(" \t");
+        if( first == string::npos || line[first] == '#' ) continue;
+        size_t last = line.find_last_not_of(" \t\r");
+        files.push_back( line.substr( first, last-first+1 ) );
+    }
+    if( files.empty() ) { cout << "No result files in " << opts.Get("--input") << endl; return 1; }
+
+    // windows <elo>:<ehi> and binnings
+    vector<pair<double,double>> windows;
+    stringstream swindows( opts.Get("--scan-windows") );
+    string window;
+    while( getline( swindows, window, ',' ) )
+    {
+        double elo, ehi;
+        char colon;
+        istringstream tokens( window );
+        if( !( tokens >> elo >> colon >> ehi ) || colon != ':' || ehi <= elo ) { cout << "Invalid window: " << window << " (expected <elo>:<ehi>)" << endl; return 1; }
+        windows.push_back( { elo, ehi } );
+    }
+    vector<int> binnings;
+    stringstream sbinnings( opts.Has("--scan-binnings") ? opts.Get("--scan-binnings") : opts.Get("--binning") );
+    string sval;
+    while( getline( sbinnings, sval, ',' ) )
+    {
+        binnings.push_back( atoi( sval.c_str() ) );
+        if( binnings.back() < 1 ) { cout << "Invalid binning: " << sval << endl; return 1; }
+    }
+    if( windows.empty() || binnings.empty() ) { cout << "No windows or binnings to scan" << endl; return 1; }
+
+    string sortby = opts.Get("--scan-sort");
+    if( sortby != "pvalue" && sortby != "deviance" && sortby != "chi2" ) { cout << "Unknown sort key: " << sortby << endl; return 1; }
+    int npar = opts.GetInt("--npar");
+
+    // one arena per worker, reset for every file
+    auto start = chrono::steady_clock::now();
+    int nthreads = GetThreads( opts );
+    vector<HistArena> arenas( nthreads );
+    vector<vector<ScanResult>> results( files.size() );
+    vector<char> failed( files.size(), 0 );
+
+    ParallelFor( files.size(), nthreads, [&]( int worker, size_t index )
+    {
+        const string & filename = files[index];
+        arenas[worker].Reset();
+        ArenaHist sdata, smc;
+
+        TFile file( filename.c_str(), "READ" );
+        TDirectory * dir = file.IsOpen() ? file.GetDirectory("results_canvas") : nullptr;
+        if( !dir || !ReadFitSpectra( *dir, arenas[worker], sdata, smc ) )
+        {
+            lock_guard<mutex> lock( OutputMutex() );
+            cout << "Skipping " << filename << ": no hSum_fine_/hMC_fine_ with equal binning" << endl;
+            failed[index] = 1;
+            return true;
+        }
+        file.Close();
+
+        for( auto & w : windows )
+        {
+            // bins whose low edge lies in [elo, ehi), none if the window is outside of the spectrum
+            int blo = max( sdata.FindBin( w.first ), 1 );
+            int bhi = min( sdata.FindBin( w.second ), sdata.GetNbinsX() );
+            if( bhi >= blo && sdata.GetBinLowEdge( bhi ) >= w.second ) bhi--;
+            if( bhi < blo )
+            {
+                lock_guard<mutex> lock( OutputMutex() );
+                cout << "Skipping window " << w.first << ":" << w.second << " of " << filename << ": outside of the spectrum" << endl;
+                continue;
+            }
+
+            for( auto rebin : binnings )
+                results[index].push_back( { filename, w.first, w.second, rebin,
+                                            WindowFitQuality( sdata.GetArray(), smc.GetArray(), blo, bhi, rebin, npar ) } );
+        }
+        return true;
+    } );
+
+    // rank per window and binning
+    vector<ScanResult> table;
+    for( auto & r : results ) table.insert( table.end(), r.begin(), r.end() );
+    auto key = [&]( const ScanResult & r )
+    {
+        const FitQuality & q = r.quality;
+        if( sortby == "pvalue" ) return -q.pvalue;
+        double value = sortby == "deviance" ? q.deviance : q.chi2;
+        return q.ndf > 0 ? value / q.ndf : numeric_limits<double>::infinity();
+    };
+    stable_sort( table.begin(), table.end(), [&]( const ScanResult & a, const ScanResult & b )
+    {
+        if( a.elo != b.elo )         return a.elo < b.elo;
+        if( a.ehi != b.ehi )         return a.ehi < b.ehi;
+        if( a.binning != b.binning ) return a.binning < b.binning;
+        return key(a) < key(b);
+    } );
+
+    if( table.empty() ) { cout << "No file and window could be scanned, no table written" << endl; return 1; }
+
+    ofstream ofout( opts.Get("--output") );
+    if( !ofout.is_open() ) { cout << "Cannot open output: " << opts.Get("--output") << endl; return 1; }
+    ofout << "elo\tehi\tbinning\trank\tfile\tnbins\tndf\tdeviance\tdeviance_ndf\tchi2\tchi2_ndf\tpvalue\n";
+    int rank = 0;
+    for( size_t i = 0; i < table.size(); i++ )
+    {
+        const ScanResult & r = table[i];
+        const FitQuality & q = r.quality;
+        if( i == 0 || r.elo != table[i-1].elo || r.ehi != table[i-1].ehi || r.binning != table[i-1].binning ) rank = 0;
+        ofout << r.elo << "\t" << r.ehi << "\t" << r.binning << "\t" << ++rank << "\t" << r.file << "\t"
+              << q.nbins << "\t" << q.ndf << "\t" << q.deviance << "\t" << ( q.ndf > 0 ? q.deviance / q.ndf : 0. ) << "\t"
+              << q.chi2 << "\t" << ( q.ndf > 0 ? q.chi2 / q.ndf : 0. ) << "\t" << q.pvalue << "\n";
+    }
+
+    size_t nfailed = count( failed.begin(), failed.end(), 1 );
+    cout << "Scanned " << files.size() - nfailed << " of " << files.size() << " files in "
+         << chrono::duration<double>( chrono::steady_clock::now() - start ).count() << " s, table in " << opts.Get("--output") << endl;
+
+    return 0;
 }
 
 string MakeLabel( TString title )
@@ -0,0 +1,131 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : columnar export of spectra, one row per histogram with bin edges,
+ *               contents and errors as variable length arrays and the metadata as
+ *               columns. Written as flat TTree "spectra" so python reads whole
+ *               columns at once (e.g. uproot arrays, which also convert to arrow)
+ *               instead of deserialising TH1D objects one by one.
+*/
+
+#ifndef SPECTRA_UTILS_COLUMNARWRITER_H
+#define SPECTRA_UTILS_COLUMNARWRITER_H
+
+// c/c++
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+// root cern
+#include "TFile.h"
+#include "TTree.h"
+#include "TH1D.h"
+
+// spectra-utils
+#include "OutputFile.h"
+
+// metadata columns of a spectrum, empty or -1 if unknown
+struct SpectrumMeta
+{
+    std::string isotope;
+    std::string location;
+    int         deadlayer = -1; // nm
+    std::string component;
+};
+
+// isotope, location and dead layer from histogram names or titles like
+// hist_dl300nm, Po210_pPlus_dl500nm_p0c1_fine_...
+inline SpectrumMeta ParseSpectrumMeta( const std::string & text )
+{
+    SpectrumMeta meta;
+    std::smatch match;
+    if( std::regex_search( text, match, std::regex("(Po210|Ra226|Rn222|Po218|Po214|Pb210|Bi212|Po212|Po216)") ) ) meta.isotope  = match[1];
+    if( std::regex_search( text, match, std::regex("(LAr|pPlus|nPlus)") ) )                                       meta.location = match[1];
+    if( std::regex_search( text, match, std::regex("([0-9]+)nm") ) )                                              meta.deadlayer = std::stoi( match[1] );
+    return meta;
+}
+
+class ColumnarWriter
+{
+  public:
+    ColumnarWriter( const std::string & filename, int compression ) :
+        fFile( filename.c_str(), "RECREATE" )
+    {
+        if( !fFile.IsOpen() ) return;
+        SetCompression( fFile, compression );
+
+        fTree = new TTree( "spectra", "spectra in columnar layout" );
+        fTree->SetDirectory( &fFile );
+        // large baskets and clusters: many spectra per basket, whole columns per read
+        fTree->SetAutoFlush( -8*1024*1024 );
+
+        fTree->Branch( "name",          &fName );
+        fTree->Branch( "isotope",       &fIsotope );
+        fTree->Branch( "location",      &fLocation );
+        fTree->Branch( "dead_layer_nm", &fDeadLayer, "dead_layer_nm/I" );
+        fTree->Branch( "component",     &fComponent );
+        fTree->Branch( "entries",       &fEntries,   "entries/D" );
+        fTree->Branch( "nbins",         &fNbins,     "nbins/I" );
+        fTree->Branch( "nedges",        &fNedges,    "nedges/I" );
+        fEdges.resize(1); fContent.resize(1); fError.resize(1);
+        fTree->Branch( "edges",         fEdges.data(),   "edges[nedges]/D",  kBasketSize );
+        fTree->Branch( "content",       fContent.data(), "content[nbins]/D", kBasketSize );
+        fTree->Branch( "error",         fError.data(),   "error[nbins]/D",   kBasketSize );
+    }
+
+    ~ColumnarWriter() { Close(); }
+
+    bool IsOpen() const { return fTree != nullptr; }
+
+    // one row, contents and errors without under- and overflow
+    void Fill( const TH1D & h, const SpectrumMeta & meta )
+    {
+        fName      = h.GetName();
+        fIsotope   = meta.isotope;
+        fLocation  = meta.location;
+        fDeadLayer = meta.deadlayer;
+        fComponent = meta.component;
+        fEntries   = h.GetEntries();
+        fNbins     = h.GetNbinsX();
+        fNedges    = fNbins + 1;
+
+        fEdges.resize( fNedges ); fContent.resize( fNbins ); fError.resize( fNbins );
+        for( int b = 1; b <= fNbins; b++ )
+        {
+            fEdges  [b-1] = h.GetXaxis()->GetBinLowEdge(b);
+            fContent[b-1] = h.GetBinContent(b);
+            fError  [b-1] = h.GetBinError(b);
+        }
+        fEdges[fNbins] = h.GetXaxis()->GetBinUpEdge(fNbins);
+
+        // buffers may have moved when resized
+        fTree->SetBranchAddress( "edges",   fEdges.data() );
+        fTree->SetBranchAddress( "content", fContent.data() );
+        fTree->SetBranchAddress( "error",   fError.data() );
+        fTree->Fill();
+    }
+
+    void Close()
+    {
+        if( !fTree ) return;
+        fFile.cd();
+        fTree->Write();
+        std::cout << "Columnar output: " << fTree->GetEntries() << " spectra in " << fFile.GetName() << std::endl;
+        fFile.Close();
+        fTree = nullptr; // deleted by fFile
+    }
+
+  private:
+    static const int kBasketSize = 1024*1024;
+
+    TFile   fFile;
+    TTree * fTree = nullptr;
+
+    std::string fName, fIsotope, fLocation, fComponent;
+    int    fDeadLayer = -1, fNbins = 0, fNedges = 0;
+    double fEntries = 0.;
+    std::vector<double> fEdges, fContent, fError;
+};
+
+#endif
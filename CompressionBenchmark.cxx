@@ -0,0 +1,190 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : write time, read time and size of real spectra for several
+ *               compression settings
+ * Compilation : g++ -O3 -std=c++1y $(root-config --cflags) CompressionBenchmark.cxx $(root-config --libs) -o CompressionBenchmark
+*/
+
+
+// c/c++
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+
+// root cern
+#include "TFile.h"
+#include "TKey.h"
+#include "TDirectory.h"
+#include "TH1.h"
+#include "TTree.h"
+#include "TClass.h"
+
+// spectra-utils
+#include "OptionParser.h"
+#include "OutputFile.h"
+
+using namespace std;
+
+// object read from the input with the directory it was found in
+struct Entry
+{
+    string path;
+    unique_ptr<TObject> object;
+};
+
+OptionParser MakeParser();
+int Run( const Options & opts );
+void ReadObjects( TDirectory & dir, string path, vector<Entry> & entries );
+void WriteObjects( TFile & file, const vector<Entry> & entries );
+int ReadBack( string filename );
+
+int main( int argc, char* argv[] )
+{
+    // get command line arguments, one job per parameter set
+    OptionParser parser = MakeParser();
+    vector<Options> jobs;
+    int status = parser.ParseCommandLine( argc, argv, jobs );
+    if( status != 0 ) return status == OptionParser::kDone ? 0 : 1;
+
+    return RunJobs( jobs, Run );
+}
+
+int Run( const Options & opts )
+{
+    string scratch = opts.Get("--scratch");
+    int repeat     = opts.GetInt("--repeat");
+    if( repeat < 1 ) { cout << "Need at least one repetition" << endl; return 1; }
+
+    // compression settings to compare
+    vector<string> settings;
+    stringstream ssettings( opts.Get("--settings") );
+    string setting;
+    while( getline( ssettings, setting, ',' ) ) settings.push_back( setting );
+
+    // keep all objects of all inputs in memory, ReadObjects detaches them from the input file
+    TH1::AddDirectory(false);
+    vector<Entry> entries;
+    for( auto & input : opts.Positional() )
+    {
+        TFile infile( input.c_str(), "READ" );
+        if( !infile.IsOpen() ) { cout << "File not Found: " << input << endl; return 1; }
+        ReadObjects( infile, "", entries );
+        infile.Close();
+    }
+    cout << entries.size() << " objects read, " << repeat << " repetitions per setting\n" << endl;
+
+    cout << setw(10) << "setting" << setw(14) << "size (kB)" << setw(14) << "write (ms)" << setw(14) << "read (ms)" << endl;
+    for( auto & spec : settings )
+    {
+        int compression;
+        if( !ParseCompression( spec, compression ) ) return 1;
+
+        double twrite = 0., tread = 0.;
+        long size = 0;
+        for( int r = 0; r < repeat; r++ )
+        {
+            auto start = chrono::steady_clock::now();
+            TFile outfile( scratch.c_str(), "RECREATE" );
+            if( !outfile.IsOpen() ) { cout << "Cannot open scratch file: " << scratch << endl; return 1; }
+            SetCompression( outfile, compression );
+            WriteObjects( outfile, entries );
+            outfile.Close();
+            auto middle = chrono::steady_clock::now();
+
+            int nread = ReadBack( scratch );
+            auto stop = chrono::steady_clock::now();
+            if( nread != (int)entries.size() ) { cout << "Read back " << nread << " of " << entries.size() << " objects" << endl; return 1; }
+
+            twrite += chrono::duration<double,milli>( middle - start ).count();
+            tread  += chrono::duration<double,milli>( stop - middle ).count();
+            TFile check( scratch.c_str(), "READ" );
+            size = check.GetSize();
+        }
+
+        cout << setw(10) << spec << setw(14) << fixed << setprecision(1) << size / 1024.
+             << setw(14) << twrite / repeat << setw(14) << tread / repeat << endl;
+    }
+    remove( scratch.c_str() );
+
+    return 0;
+}
+
+// reads all objects of dir and its subdirectories, detached from the file so they
+// outlive it: trees stay owned by the file and are copied into memory, other objects
+// a directory registers when they are read (histograms, ...) are removed from it
+void ReadObjects( TDirectory & dir, string path, vector<Entry> & entries )
+{
+    TIter next( dir.GetListOfKeys() );
+    TKey * key;
+    while( (key = (TKey*)next()) )
+    {
+        string name = key->GetName();
+        if( string(key->GetClassName()) == "TDirectoryFile" )
+        {
+            TDirectory * subdir = dir.GetDirectory( name.c_str() );
+            if( subdir ) ReadObjects( *subdir, path + name + "/", entries );
+            continue;
+        }
+        TObject * object = key->ReadObj();
+        TTree * tree = dynamic_cast<TTree*>( object );
+        if( tree )
+        {
+            TDirectory::TContext memory( nullptr );
+            object = tree->CloneTree( -1 );
+        }
+        else if( object )
+        {
+            ROOT::DirAutoAdd_t detach = object->IsA()->GetDirectoryAutoAdd();
+            if( detach ) detach( object, nullptr );
+        }
+        if( !object ) continue;
+
+        entries.push_back( { path, unique_ptr<TObject>( object ) } );
+    }
+}
+
+// writes all objects with the directory structure of the input
+void WriteObjects( TFile & file, const vector<Entry> & entries )
+{
+    for( auto & entry : entries )
+    {
+        TDirectory * dir = &file;
+        if( !entry.path.empty() )
+        {
+            string path = entry.path.substr( 0, entry.path.size()-1 );
+            dir = file.GetDirectory( path.c_str() );
+            if( !dir ) dir = file.mkdir( path.c_str() );
+        }
+        dir->cd();
+        entry.object->Write();
+    }
+    file.cd();
+}
+
+// reads (and decompresses) every object, returns the number of objects
+int ReadBack( string filename )
+{
+    TFile infile( filename.c_str(), "READ" );
+    vector<Entry> entries;
+    ReadObjects( infile, "", entries );
+    infile.Close();
+    return entries.size();
+}
+
+OptionParser MakeParser()
+{
+    OptionParser parser( "CompressionBenchmark", "Compare root compression settings on real spectra" );
+    parser.AddExample( "--repeat 5 combined.root plot-Po210pPlus.root" );
+    parser.AddPositional( "<files>", "root files whose objects are written for every setting", 1 );
+    parser.AddOption( "--settings", "-s", OptionParser::kString, "<list>", "comma separated <alg:level> list",
+                      "none,zlib:1,zlib:6,lz4:1,lz4:4,zstd:1,zstd:5,lzma:1,lzma:9" );
+    parser.AddOption( "--repeat",   "-n", OptionParser::kInt,    "<int>",  "repetitions per setting", "3" );
+    parser.AddOption( "--scratch",  "",   OptionParser::kString, "<file>", "scratch file written and read back", "compression-benchmark.root" );
+    return parser;
+}
@@ -0,0 +1,149 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : statistical convergence of summed spectra, relative errors of the
+ *               bins (sqrt of Sumw2, or of the contents if not filled with weights)
+ *               in energy windows compared to a target precision
+*/
+
+#ifndef SPECTRA_UTILS_CONVERGENCEMONITOR_H
+#define SPECTRA_UTILS_CONVERGENCEMONITOR_H
+
+// c/c++
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// spectra-utils
+#include "HistArena.h"
+
+// precision of one histogram in one window
+struct ConvergenceResult
+{
+    std::string histogram;
+    double elo, ehi;     // keV
+    double maxbin;       // largest relative error of the non-empty bins, inf if the window is empty
+    double integral;     // relative error of the window integral, inf if the window is empty
+    bool   converged;
+};
+
+class ConvergenceMonitor
+{
+  public:
+    // target relative error, checked on maxbin or on integral (useintegral)
+    ConvergenceMonitor( double target, bool useintegral = false ) : fTarget(target), fUseIntegral(useintegral) {}
+
+    // comma separated windows <elo>:<ehi> in keV
+    bool ParseWindows( const std::string & spec )
+    {
+        std::stringstream swindows( spec );
+        std::string window;
+        while( std::getline( swindows, window, ',' ) )
+        {
+            double elo, ehi;
+            char colon;
+            std::istringstream tokens( window );
+            if( !( tokens >> elo >> colon >> ehi ) || colon != ':' || ehi <= elo )
+            {
+                std::cout << "Invalid convergence window: " << window << " (expected <elo>:<ehi>)" << std::endl;
+                return false;
+            }
+            fWindows.push_back( { elo, ehi } );
+        }
+        if( fWindows.empty() ) { std::cout << "No convergence windows given" << std::endl; return false; }
+        return true;
+    }
+
+    // forget the results of the previous check
+    void Reset() { fResults.clear(); }
+
+    // evaluates all windows of h, reported as name
+    void Evaluate( const std::string & name, const ArenaHist & h )
+    {
+        for( auto & w : fWindows )
+        {
+            int blo = std::max( h.FindBin( w.first ), 1 );
+            int bhi = std::min( h.FindBin( w.second ), h.GetNbinsX() );
+            EvaluateWindow( name, w, h.GetArray(), h.GetSumw2Array(), blo, bhi );
+        }
+    }
+
+    // all windows of all evaluated histograms below the target
+    bool Converged() const
+    {
+        if( fResults.empty() ) return false;
+        for( auto & r : fResults ) if( !r.converged ) return false;
+        return true;
+    }
+
+    // the window furthest from the target
+    const ConvergenceResult * Worst() const
+    {
+        const ConvergenceResult * worst = nullptr;
+        for( auto & r : fResults )
+            if( !worst || Metric(r) > Metric(*worst) ) worst = &r;
+        return worst;
+    }
+
+    // one status line, e.g. for the log of a merge
+    void PrintStatus( std::ostream & out, long ninputs ) const
+    {
+        const ConvergenceResult * worst = Worst();
+        out << "Convergence: " << ninputs << " inputs, " << ( Converged() ? "converged" : "not converged" );
+        if( worst ) out << ", largest relative error " << Metric(*worst) << " (target " << fTarget << ") in "
+                        << worst->histogram << " " << worst->elo << ":" << worst->ehi;
+        out << std::endl;
+    }
+
+    // machine readable status: converged 0|1, inputs and target, then one line per
+    // histogram and window
+    void Write( std::ostream & out, long ninputs ) const
+    {
+        out << "converged\t" << ( Converged() ? 1 : 0 ) << "\n";
+        out << "inputs\t" << ninputs << "\n";
+        out << "target\t" << fTarget << "\t" << ( fUseIntegral ? "integral" : "max-bin" ) << "\n";
+        out << "histogram\telo\tehi\tmax_bin_rel_error\tintegral_rel_error\tconverged\n";
+        for( auto & r : fResults )
+            out << r.histogram << "\t" << r.elo << "\t" << r.ehi << "\t" << r.maxbin << "\t"
+                << r.integral << "\t" << ( r.converged ? 1 : 0 ) << "\n";
+    }
+
+  private:
+    // bins blo..bhi of the window w
+    void EvaluateWindow( const std::string & name, const std::pair<double,double> & w,
+                         const double * content, const double * sumw2, int blo, int bhi )
+    {
+        const double inf = std::numeric_limits<double>::infinity();
+
+        double maxrel2 = 0., sum = 0., sum2 = 0.;
+        for( int b = blo; b <= bhi; b++ )
+        {
+            if( content[b] <= 0. ) continue;
+            maxrel2 = std::max( maxrel2, sumw2[b] / ( content[b] * content[b] ) );
+            sum  += content[b];
+            sum2 += sumw2[b];
+        }
+
+        ConvergenceResult result;
+        result.histogram = name;
+        result.elo       = w.first;
+        result.ehi       = w.second;
+        result.maxbin    = sum > 0. ? std::sqrt( maxrel2 )    : inf;
+        result.integral  = sum > 0. ? std::sqrt( sum2 ) / sum : inf;
+        result.converged = ( fUseIntegral ? result.integral : result.maxbin ) <= fTarget;
+        fResults.push_back( result );
+    }
+
+    double Metric( const ConvergenceResult & r ) const { return fUseIntegral ? r.integral : r.maxbin; }
+
+    double fTarget;
+    bool   fUseIntegral;
+    std::vector<std::pair<double,double>> fWindows;
+    std::vector<ConvergenceResult>        fResults;
+};
+
+#endif
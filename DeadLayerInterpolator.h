@@ -0,0 +1,139 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : spectra for any dead layer thickness between the simulated
+ *               hist_dl<x>nm points of gerda-mage-sim/alphas
+ *
+ *               linear : bin by bin interpolation of the two neighbouring points
+ *               morph  : interpolation of the quantile functions (inverse CDFs)
+ *                        of the neighbouring points, moves the alpha peak and its
+ *                        low energy tail continuously instead of cross fading
+ *               the total integral is interpolated linearly in both modes
+*/
+
+#ifndef SPECTRA_UTILS_DEADLAYERINTERPOLATOR_H
+#define SPECTRA_UTILS_DEADLAYERINTERPOLATOR_H
+
+// c/c++
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+class DeadLayerInterpolator
+{
+  public:
+    enum Mode { kLinear, kMorph };
+
+    // all points share a fixed binning of nbins between xmin and xmax,
+    // nquantiles is the resolution of the quantile tables (0 = 2 * nbins)
+    DeadLayerInterpolator( int nbins, double xmin, double xmax, int nquantiles = 0 ) :
+        fNbins(nbins), fXmin(xmin), fXmax(xmax), fNq( nquantiles > 0 ? nquantiles : 2*nbins ) {}
+
+    // adds a simulated point, contents are the nbins bins without under- and overflow
+    // points have to be added with increasing dead layer
+    void AddPoint( double deadlayer, const double * contents )
+    {
+        if( !fDeadLayer.empty() && deadlayer <= fDeadLayer.back() )
+            throw std::invalid_argument( "dead layer points have to be increasing" );
+
+        fDeadLayer.push_back( deadlayer );
+        fContents.insert( fContents.end(), contents, contents + fNbins );
+
+        // quantile function at q = j/nq, j = 0..nq, from the piecewise linear CDF
+        std::vector<double> cdf( fNbins+1, 0. );
+        for( int b = 0; b < fNbins; b++ ) cdf[b+1] = cdf[b] + std::max( contents[b], 0. );
+        double integral = cdf[fNbins];
+        fIntegral.push_back( integral );
+
+        double width = ( fXmax - fXmin ) / fNbins;
+        int b = 0;
+        for( int j = 0; j <= fNq; j++ )
+        {
+            double level = integral * j / fNq;
+            while( b < fNbins-1 && ( cdf[b+1] < level || cdf[b+1] == cdf[b] ) ) b++;
+            double inbin = cdf[b+1] - cdf[b];
+            double frac  = inbin > 0. ? ( level - cdf[b] ) / inbin : 0.;
+            fQuantiles.push_back( fXmin + ( b + std::min( std::max( frac, 0. ), 1. ) ) * width );
+        }
+    }
+
+    int    GetNbins()         const { return fNbins; }
+    int    GetNpoints()       const { return fDeadLayer.size(); }
+    double GetMinDeadLayer()  const { return fDeadLayer.front(); }
+    double GetMaxDeadLayer()  const { return fDeadLayer.back(); }
+
+    // writes the spectrum at deadlayer into out[nbins]
+    void Evaluate( double deadlayer, Mode mode, double * out ) const
+    {
+        if( fDeadLayer.size() < 2 ) throw std::logic_error( "need at least two dead layer points" );
+        if( deadlayer < fDeadLayer.front() || deadlayer > fDeadLayer.back() )
+            throw std::out_of_range( "dead layer outside of simulated range" );
+
+        // neighbouring points i and i+1 with deadlayer in [dl_i, dl_i+1]
+        size_t i = std::upper_bound( fDeadLayer.begin(), fDeadLayer.end(), deadlayer ) - fDeadLayer.begin();
+        i = std::min( std::max( i, (size_t)1 ), fDeadLayer.size()-1 ) - 1;
+        double t = ( deadlayer - fDeadLayer[i] ) / ( fDeadLayer[i+1] - fDeadLayer[i] );
+
+        // morphing needs a shape on both sides
+        if( mode == kLinear || fIntegral[i] <= 0. || fIntegral[i+1] <= 0. ) Linear( i, t, out );
+        else                                                                 Morph ( i, t, out );
+    }
+
+    std::vector<double> Evaluate( double deadlayer, Mode mode ) const
+    {
+        std::vector<double> out( fNbins );
+        Evaluate( deadlayer, mode, out.data() );
+        return out;
+    }
+
+  private:
+    void Linear( size_t i, double t, double * out ) const
+    {
+        const double * a = &fContents[ i    * fNbins];
+        const double * b = &fContents[(i+1) * fNbins];
+        for( int k = 0; k < fNbins; k++ ) out[k] = a[k] + t * ( b[k] - a[k] );
+    }
+
+    void Morph( size_t i, double t, double * out ) const
+    {
+        const double * qa = &fQuantiles[ i    * (fNq+1)];
+        const double * qb = &fQuantiles[(i+1) * (fNq+1)];
+
+        // every interval [q_j, q_j+1] of the interpolated quantile function holds
+        // integral/nq, spread uniformly; q is computed on the fly, so Evaluate keeps no
+        // state and one interpolator can be shared by threads
+        std::fill( out, out + fNbins, 0. );
+        double mass  = ( fIntegral[i] + t * ( fIntegral[i+1] - fIntegral[i] ) ) / fNq;
+        double scale = fNbins / ( fXmax - fXmin );
+        double qhi   = qa[0] + t * ( qb[0] - qa[0] );
+        for( int j = 0; j < fNq; j++ )
+        {
+            double qlo = qhi;
+            qhi = qa[j+1] + t * ( qb[j+1] - qa[j+1] );
+            double ulo = ( qlo - fXmin ) * scale;
+            double uhi = ( qhi - fXmin ) * scale;
+            int blo = std::min( (int)ulo, fNbins-1 );
+            int bhi = std::min( (int)uhi, fNbins-1 );
+
+            if( blo == bhi || uhi <= ulo ) { out[blo] += mass; continue; }
+
+            double density = mass / ( uhi - ulo );
+            out[blo] += density * ( blo + 1 - ulo );
+            for( int b = blo+1; b < bhi; b++ ) out[b] += density;
+            out[bhi] += density * ( uhi - bhi );
+        }
+    }
+
+    int    fNbins;
+    double fXmin, fXmax;
+    int    fNq;
+
+    // per point, point major so the two neighbours of a query are contiguous
+    std::vector<double> fDeadLayer;
+    std::vector<double> fIntegral;
+    std::vector<double> fContents;   // [point][bin]
+    std::vector<double> fQuantiles;  // [point][quantile]
+};
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : sums of detector channels over detector groups (enrBEGe, enrCoax,
+ *               natCoax, strings, ...) for channel resolved histograms
+*/
+
+#ifndef SPECTRA_UTILS_DETECTORGROUPS_H
+#define SPECTRA_UTILS_DETECTORGROUPS_H
+
+// c/c++
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class DetectorGroups
+{
+  public:
+    // channels are the detector names of the histogram bins, "-" for unused channels
+    DetectorGroups( const std::vector<std::string> & channels ) : fChannels(channels) {}
+
+    // groups by detector type: GD enrBEGe, ANG and RG enrCoax, GTF natCoax
+    void AddTypeGroups()
+    {
+        const std::vector<std::pair<std::string,std::vector<std::string>>> types =
+            { { "enrBEGe", {"GD"} }, { "enrCoax", {"ANG","RG"} }, { "natCoax", {"GTF"} } };
+
+        for( auto & type : types )
+        {
+            std::vector<std::string> members;
+            for( auto & channel : fChannels )
+                for( auto & prefix : type.second )
+                    if( channel.compare( 0, prefix.size(), prefix ) == 0 ) members.push_back( channel );
+            AddGroup( type.first, members );
+        }
+    }
+
+    // group map file, one group per line: <group> <detector> <detector> ...
+    // a detector may be part of several groups, # starts a comment
+    bool ReadGroups( const std::string & filename )
+    {
+        std::ifstream ifgroups( filename );
+        if( !ifgroups.is_open() ) { std::cout << "Group file not Found: " << filename << std::endl; return false; }
+
+        std::string line;
+        while( std::getline( ifgroups, line ) )
+        {
+            auto hash = line.find('#');
+            if( hash != std::string::npos ) line.erase(hash);
+
+            std::istringstream tokens( line );
+            std::string group, detector;
+            if( !( tokens >> group ) ) continue;
+            std::vector<std::string> members;
+            while( tokens >> detector ) members.push_back( detector );
+            if( !AddGroup( group, members ) ) return false;
+        }
+        return true;
+    }
+
+    // adds a group of detectors, false if a detector is not one of the channels
+    bool AddGroup( const std::string & group, const std::vector<std::string> & members )
+    {
+        std::vector<double> weights( fChannels.size(), 0. );
+        for( auto & member : members )
+        {
+            size_t c = 0;
+            while( c < fChannels.size() && fChannels[c] != member ) c++;
+            if( c == fChannels.size() ) { std::cout << "Unknown detector " << member << " in group " << group << std::endl; return false; }
+            weights[c] = 1.;
+        }
+        fGroups.push_back( group );
+        fWeights.insert( fWeights.end(), weights.begin(), weights.end() );
+        return true;
+    }
+
+    size_t GetNgroups()   const { return fGroups.size(); }
+    size_t GetNchannels() const { return fChannels.size(); }
+    const std::vector<std::string> & GetGroups() const { return fGroups; }
+
+    // group sums of all inputs in one pass, contents[f] points to the nchannels
+    // channel contents of input f, result is the ninputs x ngroups matrix (row major)
+    std::vector<double> Sum( const std::vector<const double*> & contents ) const
+    {
+        size_t nch = fChannels.size(), ngr = fGroups.size();
+        std::vector<double> sums( contents.size() * ngr, 0. );
+
+        for( size_t f = 0; f < contents.size(); f++ )
+        {
+            const double * x = contents[f];
+            for( size_t g = 0; g < ngr; g++ )
+            {
+                const double * w = &fWeights[g * nch];
+                double sum = 0.;
+                for( size_t c = 0; c < nch; c++ ) sum += w[c] * x[c];
+                sums[f * ngr + g] = sum;
+            }
+        }
+        return sums;
+    }
+
+  private:
+    std::vector<std::string> fChannels;
+    std::vector<std::string> fGroups;
+    std::vector<double>      fWeights; // [group][channel], 1 if channel is part of group
+};
+
+#endif
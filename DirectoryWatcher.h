@@ -0,0 +1,79 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : inotify watch (linux) for files written to or moved into directories,
+ *               a file is reported once it is closed, never while it is being written
+*/
+
+#ifndef SPECTRA_UTILS_DIRECTORYWATCHER_H
+#define SPECTRA_UTILS_DIRECTORYWATCHER_H
+
+// c/c++
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// linux
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+class DirectoryWatcher
+{
+  public:
+    DirectoryWatcher() : fFd( inotify_init1( IN_NONBLOCK | IN_CLOEXEC ) )
+    {
+        if( fFd < 0 ) std::cout << "Cannot initialise inotify: " << std::strerror(errno) << std::endl;
+    }
+    ~DirectoryWatcher() { if( fFd >= 0 ) close( fFd ); }
+
+    DirectoryWatcher( const DirectoryWatcher & ) = delete;
+    DirectoryWatcher & operator=( const DirectoryWatcher & ) = delete;
+
+    bool IsOpen() const { return fFd >= 0; }
+
+    // files closed after writing and files renamed into dir are reported
+    bool AddDirectory( std::string dir )
+    {
+        int wd = inotify_add_watch( fFd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO );
+        if( wd < 0 ) { std::cout << "Cannot watch directory: " << dir << " (" << std::strerror(errno) << ")" << std::endl; return false; }
+        if( dir.back() != '/' ) dir += "/";
+        fDirs[wd] = dir;
+        return true;
+    }
+
+    // waits up to timeout ms (-1 forever) and appends the paths of all files reported
+    // meanwhile to files, false on error, true with no files on timeout or signal
+    bool Wait( int timeout, std::vector<std::string> & files )
+    {
+        pollfd pfd = { fFd, POLLIN, 0 };
+        int n = poll( &pfd, 1, timeout );
+        if( n < 0 && errno != EINTR ) { std::cout << "Watch failed: " << std::strerror(errno) << std::endl; return false; }
+        if( n <= 0 ) return true;
+
+        alignas(inotify_event) char buffer[4096];
+        ssize_t len;
+        while( ( len = read( fFd, buffer, sizeof(buffer) ) ) > 0 )
+        {
+            for( char * ptr = buffer; ptr < buffer + len; )
+            {
+                const inotify_event * event = (const inotify_event*)ptr;
+                ptr += sizeof(inotify_event) + event->len;
+
+                if( event->mask & IN_Q_OVERFLOW ) std::cout << "Warning: watch queue overflow, files were missed" << std::endl;
+                if( event->len == 0 || ( event->mask & IN_ISDIR ) ) continue;
+                files.push_back( fDirs[event->wd] + event->name );
+            }
+        }
+        return true;
+    }
+
+  private:
+    int fFd;
+    std::map<int,std::string> fDirs; // watch descriptor -> directory
+};
+
+#endif
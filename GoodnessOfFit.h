@@ -0,0 +1,55 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : goodness of fit of a binned model to data in an energy window,
+ *               poisson deviance (likelihood ratio), pearson chi2 and p-value
+*/
+
+#ifndef SPECTRA_UTILS_GOODNESSOFFIT_H
+#define SPECTRA_UTILS_GOODNESSOFFIT_H
+
+// c/c++
+#include <cmath>
+#include <limits>
+
+// root cern
+#include "TMath.h"
+
+struct FitQuality
+{
+    int    nbins    = 0;  // merged bins used
+    int    ndf      = 0;  // nbins - fit parameters
+    double deviance = 0.; // 2 sum( m - d + d ln(d/m) )
+    double chi2     = 0.; // sum (d-m)^2 / m
+    double pvalue   = 0.; // of the deviance for a chi2 distribution with ndf
+};
+
+// data and model in bins blo..bhi, merged rebin bins at a time (the last group may be
+// smaller), bins without model and data are skipped, data without model is infinitely
+// unlikely; npar fit parameters are subtracted from the degrees of freedom
+inline FitQuality WindowFitQuality( const double * data, const double * model, int blo, int bhi, int rebin, int npar = 0 )
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    FitQuality q;
+
+    for( int first = blo; first <= bhi; first += rebin )
+    {
+        double d = 0., m = 0.;
+        for( int b = first; b < first + rebin && b <= bhi; b++ ) { d += data[b]; m += model[b]; }
+
+        if( m <= 0. )
+        {
+            if( d > 0. ) { q.deviance = inf; q.chi2 = inf; q.nbins++; }
+            continue;
+        }
+        q.deviance += 2. * ( m - d + ( d > 0. ? d * std::log( d / m ) : 0. ) );
+        q.chi2     += ( d - m ) * ( d - m ) / m;
+        q.nbins++;
+    }
+
+    q.ndf = q.nbins - npar;
+    if( q.ndf > 0 && std::isfinite( q.deviance ) ) q.pvalue = TMath::Prob( q.deviance, q.ndf );
+    return q;
+}
+
+#endif
@@ -0,0 +1,233 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : light weight histogram values whose bins live in an arena, moved
+ *               instead of copied and converted to TH1D only for drawing and writing.
+ *               An arena hands out memory from large blocks and frees it all at once,
+ *               Reset() reuses the blocks so loops over many files allocate nothing.
+*/
+
+#ifndef SPECTRA_UTILS_HISTARENA_H
+#define SPECTRA_UTILS_HISTARENA_H
+
+// c/c++
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+// root cern
+#include "TH1D.h"
+
+// bump allocator for bin arrays, not thread safe (one arena per worker)
+class HistArena
+{
+  public:
+    // blocksize in doubles, larger requests get a block of their own
+    explicit HistArena( size_t blocksize = 1 << 20 ) : fBlockSize(blocksize) {}
+
+    HistArena( const HistArena & ) = delete;
+    HistArena & operator=( const HistArena & ) = delete;
+    HistArena( HistArena && ) = default;
+    HistArena & operator=( HistArena && ) = default;
+
+    // n doubles set to zero, valid until Reset() or destruction of the arena
+    double * Allocate( size_t n )
+    {
+        while( fCurrent < fBlocks.size() && fUsed + n > fSizes[fCurrent] ) { fCurrent++; fUsed = 0; }
+        if( fCurrent == fBlocks.size() )
+        {
+            size_t size = std::max( n, fBlockSize );
+            fBlocks.emplace_back( new double[size] );
+            fSizes.push_back( size );
+            fUsed = 0;
+        }
+        double * ptr = fBlocks[fCurrent].get() + fUsed;
+        fUsed += n;
+        std::fill( ptr, ptr + n, 0. );
+        return ptr;
+    }
+
+    // invalidates all histograms of this arena, keeps the blocks for reuse
+    void Reset() { fCurrent = 0; fUsed = 0; }
+
+  private:
+    size_t fBlockSize;
+    size_t fCurrent = 0;  // block in use
+    size_t fUsed    = 0;  // doubles used in the current block
+    std::vector<std::unique_ptr<double[]>> fBlocks;
+    std::vector<size_t>                    fSizes;
+};
+
+// 1D histogram with under- and overflow, contents and sum of squared weights
+// contiguous in an arena, move only
+class ArenaHist
+{
+  public:
+    ArenaHist() = default;
+
+    // copy of the bins and the axis titles and attributes of h
+    ArenaHist( HistArena & arena, const TH1D & h, const std::string & name ) :
+        fName(name), fTitle(h.GetTitle()), fXTitle(h.GetXaxis()->GetTitle()), fYTitle(h.GetYaxis()->GetTitle()),
+        fXAttributes(*h.GetXaxis()), fYAttributes(*h.GetYaxis()), fNbins(h.GetNbinsX()),
+        fXmin(h.GetXaxis()->GetXmin()), fXmax(h.GetXaxis()->GetXmax())
+    {
+        Allocate( arena, h.GetXaxis()->GetXbins()->GetSize() > 0 ? h.GetXaxis()->GetXbins()->GetArray() : nullptr );
+        Add( h );
+    }
+
+    // empty histogram with fixed bins
+    ArenaHist( HistArena & arena, const std::string & name, int nbins, double xmin, double xmax ) :
+        fName(name), fTitle(name), fNbins(nbins), fXmin(xmin), fXmax(xmax)
+    {
+        Allocate( arena, nullptr );
+    }
+
+    // copy of other in arena
+    ArenaHist( HistArena & arena, const ArenaHist & other ) :
+        fName(other.fName), fTitle(other.fTitle), fXTitle(other.fXTitle), fYTitle(other.fYTitle),
+        fXAttributes(other.fXAttributes), fYAttributes(other.fYAttributes),
+        fNbins(other.fNbins), fXmin(other.fXmin), fXmax(other.fXmax)
+    {
+        Allocate( arena, other.fEdges );
+        Add( other );
+    }
+
+    ArenaHist( const ArenaHist & ) = delete;
+    ArenaHist & operator=( const ArenaHist & ) = delete;
+    ArenaHist( ArenaHist && other ) noexcept { *this = std::move(other); }
+    ArenaHist & operator=( ArenaHist && other ) noexcept
+    {
+        fName = std::move(other.fName); fTitle = std::move(other.fTitle);
+        fXTitle = std::move(other.fXTitle); fYTitle = std::move(other.fYTitle);
+        fXAttributes = other.fXAttributes; fYAttributes = other.fYAttributes;
+        fNbins = other.fNbins; fXmin = other.fXmin; fXmax = other.fXmax; fEntries = other.fEntries;
+        fHasSumw2 = other.fHasSumw2;
+        fEdges = other.fEdges; fContent = other.fContent; fSumw2 = other.fSumw2;
+        other.fNbins = 0; other.fEdges = nullptr; other.fContent = nullptr; other.fSumw2 = nullptr;
+        return *this;
+    }
+
+    // same number of bins, range and (variable) bin edges
+    bool SameBinning( const TH1D & h ) const
+    {
+        const TArrayD * edges = h.GetXaxis()->GetXbins();
+        return SameBinning( h.GetNbinsX(), h.GetXaxis()->GetXmin(), h.GetXaxis()->GetXmax(),
+                            edges->GetSize() > 0 ? edges->GetArray() : nullptr );
+    }
+
+    bool SameBinning( const ArenaHist & other ) const
+    {
+        return SameBinning( other.fNbins, other.fXmin, other.fXmax, other.fEdges );
+    }
+
+    // bin by bin sum, false and nothing added if the binning differs; without Sumw2
+    // the contents of h are its squared errors, like in TH1::Add
+    bool Add( const TH1D & h )
+    {
+        if( !SameBinning( h ) ) return false;
+        const double * content = h.GetArray();
+        const double * sumw2   = h.GetSumw2N() ? h.GetSumw2()->GetArray() : content;
+        AddArrays( content, sumw2, h.GetEntries() );
+        fHasSumw2 |= h.GetSumw2N() > 0;
+        return true;
+    }
+
+    bool Add( const ArenaHist & other )
+    {
+        if( !SameBinning( other ) ) return false;
+        AddArrays( other.fContent, other.fSumw2, other.fEntries );
+        fHasSumw2 |= other.fHasSumw2;
+        return true;
+    }
+
+    const std::string & GetName()  const { return fName; }
+    const std::string & GetTitle() const { return fTitle; }
+
+    int    GetNbinsX()             const { return fNbins; }
+    double GetEntries()            const { return fEntries; }
+    double GetBinContent( int b )  const { return fContent[b]; }
+    double GetBinError( int b )    const { return std::sqrt( fSumw2[b] ); }
+    double GetBinLowEdge( int b )  const { return fEdges ? fEdges[b-1] : fXmin + ( b - 1 ) * ( fXmax - fXmin ) / fNbins; }
+
+    // nbins+2 contents and squared errors, bin 0 is the underflow
+    double       * GetArray()            { return fContent; }
+    const double * GetArray()      const { return fContent; }
+    const double * GetSumw2Array() const { return fSumw2; }
+
+    // bin containing x, 0 underflow, nbins+1 overflow
+    int FindBin( double x ) const
+    {
+        if( x < fXmin )  return 0;
+        if( x >= fXmax ) return fNbins + 1;
+        if( fEdges ) return std::upper_bound( fEdges, fEdges + fNbins + 1, x ) - fEdges;
+        return 1 + std::min( (int)( ( x - fXmin ) * fNbins / ( fXmax - fXmin ) ), fNbins - 1 );
+    }
+
+    double Integral() const
+    {
+        double sum = 0.;
+        for( int b = 1; b <= fNbins; b++ ) sum += fContent[b];
+        return sum;
+    }
+
+    // sets h to this histogram (binning, name, titles, axis attributes, bins, entries),
+    // h may be reused
+    void CopyTo( TH1D & h ) const
+    {
+        if( fEdges ) h.SetBins( fNbins, fEdges );
+        else         h.SetBins( fNbins, fXmin, fXmax );
+        h.SetName( fName.c_str() );
+        h.SetTitle( fTitle.c_str() );
+        h.GetXaxis()->SetTitle( fXTitle.c_str() );
+        h.GetYaxis()->SetTitle( fYTitle.c_str() );
+        fXAttributes.Copy( *h.GetXaxis() );
+        fYAttributes.Copy( *h.GetYaxis() );
+
+        if( fHasSumw2 && h.GetSumw2N() == 0 ) h.Sumw2();
+        if( !fHasSumw2 && h.GetSumw2N() > 0 ) h.Sumw2( false );
+        std::copy( fContent, fContent + fNbins + 2, h.GetArray() );
+        if( fHasSumw2 ) std::copy( fSumw2, fSumw2 + fNbins + 2, h.GetSumw2()->GetArray() );
+        h.SetEntries( fEntries );
+    }
+
+  private:
+    bool SameBinning( int nbins, double xmin, double xmax, const double * edges ) const
+    {
+        if( nbins != fNbins || xmin != fXmin || xmax != fXmax ) return false;
+        if( !edges || !fEdges ) return !edges && !fEdges;
+        return std::equal( edges, edges + fNbins + 1, fEdges );
+    }
+
+    void Allocate( HistArena & arena, const double * edges )
+    {
+        fContent = arena.Allocate( 2 * ( fNbins + 2 ) );
+        fSumw2   = fContent + fNbins + 2;
+        if( edges )
+        {
+            double * copy = arena.Allocate( fNbins + 1 );
+            std::copy( edges, edges + fNbins + 1, copy );
+            fEdges = copy;
+        }
+    }
+
+    void AddArrays( const double * content, const double * sumw2, double entries )
+    {
+        for( int b = 0; b < fNbins + 2; b++ ) { fContent[b] += content[b]; fSumw2[b] += sumw2[b]; }
+        fEntries += entries;
+    }
+
+    std::string fName, fTitle;
+    std::string fXTitle, fYTitle;
+    TAttAxis    fXAttributes, fYAttributes; // label and title sizes, offsets, divisions, ...
+    int      fNbins    = 0;
+    double   fXmin     = 0., fXmax = 0.;
+    double   fEntries  = 0.;
+    bool     fHasSumw2 = false;
+    const double * fEdges   = nullptr; // nbins+1 edges if variable bins
+    double       * fContent = nullptr;
+    double       * fSumw2   = nullptr;
+};
+
+#endif
@@ -8,73 +8,542 @@
 
 // c/c++
 #include <iostream>
+#include <fstream>
 #include <cstdlib>
+#include <cstdio>
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
+#include <mutex>
+#include <regex>
+#include <chrono>
+#include <csignal>
+#include <climits>
+#include <memory>
 
 // root cern
 #include "TH1D.h"
 #include "TFile.h"
 
+// spectra-utils
+#include "OptionParser.h"
+#include "OutputFile.h"
+#include "ParallelIO.h"
+#include "ColumnarWriter.h"
+#include "MergeInfo.h"
+#include "DirectoryWatcher.h"
+#include "ConvergenceMonitor.h"
+#include "HistArena.h"
+
 using namespace std;
 
+OptionParser MakeParser();
+int Run( const Options & opts );
+bool ReadInputList( string listname, vector<string> & files );
+bool MergeFiles( const vector<string> & files, map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, vector<HistArena> & warena, HistArena & arena );
+bool AddFile( const string & file, map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, HistArena & arena );
+bool AddSums( map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, map<string,ArenaHist> & hadd, map<string,MergeInfo> & iadd, HistArena & arena );
+bool WriteHistograms( string output, map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, int compression );
+bool MergeChunked( vector<string> & files, string output, int chunksize, int compression, vector<HistArena> & warena, vector<string> & partials_all );
+void WriteColumnar( string filename, map<string,ArenaHist> & hmap, const Options & opts, int compression );
+string PartialName( string output, int level, int index );
+bool WatchDirectories( const Options & opts, DirectoryWatcher & watcher, set<string> & added, string output, map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, HistArena & arena, int compression, ConvergenceMonitor * monitor );
+bool UpdateOutput( string output, map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, int compression, string command );
+string CanonicalName( string path );
+bool CheckConvergence( ConvergenceMonitor & monitor, map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, string statusfile );
+
 int main( int argc, char* argv[] )
+{
+    // get command line arguments, one job per parameter set
+    OptionParser parser = MakeParser();
+    vector<Options> jobs;
+    int status = parser.ParseCommandLine( argc, argv, jobs );
+    if( status != 0 ) return status == OptionParser::kDone ? 0 : 1;
+
+    return RunJobs( jobs, Run );
+}
+
+int Run( const Options & opts )
 {
     cout << "Combining histograms" << endl;
 
-    // read in file names
-    vector<string> files;
-    for( int i = 1; i < argc-1; i++ ) files.push_back( argv[i] );
+    // read in file names, last positional argument is the output
+    vector<string> files = opts.Positional();
+    string output = files.back();
+    files.pop_back();
+
+    // input lists, "-" reads from stdin
+    if( opts.Has("--input-list") && !ReadInputList( opts.Get("--input-list"), files ) ) return 1;
+    if( files.empty() && !opts.Has("--watch") ) { cout << "No input files given" << endl; return 1; }
+
+    int compression;
+    if( !GetCompression( opts, compression ) ) return 1;
 
-    // vector to hold summed histograms
-    map<string,TH1D> hmap;
+    int nthreads = GetThreads( opts );
 
-    // loop over files
-    for( auto file : files )
+    int chunksize = opts.GetInt("--chunk-size");
+    if( chunksize < 0 ) { cout << "Chunk size has to be positive" << endl; return 1; }
+
+    // map stage: merge only one chunk of the input list into a partial sum
+    if( opts.Has("--chunk-index") )
     {
-        cout << "\t" << file << endl;
-        TFile rootfile( file.c_str() );
+        int index = opts.GetInt("--chunk-index");
+        if( chunksize == 0 ) { cout << "--chunk-index requires --chunk-size" << endl; return 1; }
+        if( opts.Has("--watch") ) { cout << "--chunk-index cannot be combined with --watch" << endl; return 1; }
+        size_t first = (size_t)index * chunksize;
+        if( index < 0 || first >= files.size() ) { cout << "Chunk " << index << " out of range" << endl; return 1; }
+        size_t last = min( first + chunksize, files.size() );
+        files = vector<string>( files.begin() + first, files.begin() + last );
+        cout << "Chunk " << index << ": files " << first << " - " << last-1 << endl;
+    }
 
-        // loop over histograms
-        for( int dl = 0; dl <= 1000; dl += 100 )
-        {
-            string hname  = "hist_dl"; hname  += to_string(dl); hname  += "nm";
-            string hcname = "hist_dl"; hcname += to_string(dl); hcname += "nm_copy";
+    // watch mode: the directories are watched before the inputs are merged, files closed
+    // meanwhile are added afterwards; every file is added once, inputs included
+    unique_ptr<DirectoryWatcher> watcher;
+    set<string> added;
+    if( opts.Has("--watch") )
+    {
+        watcher.reset( new DirectoryWatcher );
+        if( !watcher->IsOpen() ) return 1;
+        stringstream sdirs( opts.Get("--watch") );
+        string dir;
+        while( getline( sdirs, dir, ',' ) ) if( !watcher->AddDirectory( dir ) ) return 1;
+        for( auto & file : files ) added.insert( CanonicalName( file ) );
+    }
 
-            TH1D h = *(TH1D*)rootfile.Get( hname.c_str() );
+    // one arena per worker for the whole run, reset by every merge
+    vector<HistArena> warena( nthreads );
 
-            if( hmap.find(hname) == hmap.end() ) hmap[hname] = *(TH1D*)h.Clone( hcname.c_str() );
-            else
+    // local run: merge in chunks and reduce the partial sums hierarchically
+    vector<string> partials;
+    if( !opts.Has("--chunk-index") && chunksize > 0 && (int)files.size() > chunksize )
+    {
+        if( chunksize < 2 ) { cout << "Hierarchical merge needs a chunk size of at least 2" << endl; return 1; }
+        if( !MergeChunked( files, output, chunksize, compression, warena, partials ) ) return 1;
+    }
+
+    // convergence monitor (optional)
+    unique_ptr<ConvergenceMonitor> monitor;
+    if( opts.Has("--conv-target") )
+    {
+        string metric = opts.Get("--conv-metric");
+        if( metric != "max-bin" && metric != "integral" ) { cout << "Unknown convergence metric: " << metric << endl; return 1; }
+        monitor.reset( new ConvergenceMonitor( opts.GetDouble("--conv-target"), metric == "integral" ) );
+        if( !monitor->ParseWindows( opts.Get("--conv-window") ) ) return 1;
+    }
+    else if( opts.Has("--conv-window") || opts.Has("--conv-output") || opts.Has("--conv-stop") ) { cout << "Convergence options require --conv-target" << endl; return 1; }
+    int every = opts.GetInt("--conv-every");
+    if( every < 0 ) { cout << "--conv-every has to be positive" << endl; return 1; }
+
+    // maps to hold summed histograms and their totals, bins in arena
+    HistArena arena;
+    map<string,ArenaHist> hmap;
+    map<string,MergeInfo> imap;
+    if( monitor && every > 0 )
+    {
+        // add the inputs in batches and check the convergence after each batch
+        HistArena batcharena;
+        for( size_t first = 0; first < files.size(); first += every )
+        {
+            batcharena.Reset();
+            size_t last = min( first + every, files.size() );
+            vector<string> batch( files.begin() + first, files.begin() + last );
+            map<string,ArenaHist> hbatch;
+            map<string,MergeInfo> ibatch;
+            if( !MergeFiles( batch, hbatch, ibatch, warena, batcharena ) ) return 1;
+            if( !AddSums( hmap, imap, hbatch, ibatch, arena ) ) return 1;
+
+            bool converged = CheckConvergence( *monitor, hmap, imap, opts.Get("--conv-output") );
+            if( converged && opts.Has("--conv-stop") && last < files.size() )
             {
-                // loop over bins
-                int nbins = h.GetNbinsX();
-                for( int b = 1; b <= nbins; b++ )
-                {
-                    //double center  = h.GetBinCenter(b);
-                    double content = h.GetBinContent(b);
-                    //int bin = hmap[hname].FindBin(center);
-                    hmap[hname].Fill(b,content);
-                }
+                cout << "Converged, skipping the remaining " << files.size() - last << " inputs" << endl;
+                break;
             }
         }
+    }
+    else
+    {
+        if( !MergeFiles( files, hmap, imap, warena, arena ) ) return 1;
+        if( monitor && !hmap.empty() ) CheckConvergence( *monitor, hmap, imap, opts.Get("--conv-output") );
+    }
+    if( !files.empty() && !WriteHistograms( output, hmap, imap, compression ) ) return 1;
+
+    if( !opts.Has("--keep-partials") ) for( auto & partial : partials ) remove( partial.c_str() );
+
+    // watch mode: keep adding new files until stopped
+    bool done = monitor && opts.Has("--conv-stop") && monitor->Converged();
+    if( watcher && !done && !WatchDirectories( opts, *watcher, added, output, hmap, imap, arena, compression, monitor.get() ) ) return 1;
 
-        rootfile.Close();
+    // columnar export (optional)
+    if( opts.Has("--columnar") && !hmap.empty() ) WriteColumnar( opts.Get("--columnar"), hmap, opts, compression );
+
+    return 0;
+}
+
+// reads one file name per line, empty lines and lines starting with # are skipped
+bool ReadInputList( string listname, vector<string> & files )
+{
+    ifstream iflist;
+    if( listname != "-" )
+    {
+        iflist.open( listname );
+        if( !iflist.is_open() ) { cout << "Input list not Found: " << listname << endl; return false; }
+    }
+    istream & in = ( listname == "-" ) ? cin : iflist;
+
+    string line;
+    while( getline( in, line ) )
+    {
+        size_t first = line.find_first_not_of(" \t");
+        if( first == string::npos || line[first] == '#' ) continue;
+        size_t last = line.find_last_not_of(" \t\r");
+        files.push_back( line.substr( first, last-first+1 ) );
     }
+    return true;
+}
+
+// adds hist_dl<x>nm of all files to hmap and their totals to imap, every worker
+// sums a fixed contiguous block of files in list order, the worker sums are added
+// in worker order at the end. Weighted sums are therefore reproducible for the same
+// input list and --threads, but rounding may differ between thread counts.
+// warena holds one arena per worker, they are reset and their blocks reused.
+bool MergeFiles( const vector<string> & files, map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, vector<HistArena> & warena, HistArena & arena )
+{
+    int nthreads = warena.size();
+    for( auto & a : warena ) a.Reset();
+    vector<map<string,ArenaHist>> whmap( nthreads );
+    vector<map<string,MergeInfo>> wimap( nthreads );
+
+    bool ok = ParallelForBlocks( files.size(), nthreads, [&]( int worker, size_t index )
+    {
+        return AddFile( files[index], whmap[worker], wimap[worker], warena[worker] );
+    } );
+    if( !ok ) return false;
+
+    for( int w = 0; w < nthreads; w++ ) if( !AddSums( hmap, imap, whmap[w], wimap[w], arena ) ) return false;
+
+    return true;
+}
+
+// adds the sums hadd and their totals iadd to hmap and imap, new sums are copied to
+// arena; false if the binning of a sum differs, hmap and imap are unchanged then
+bool AddSums( map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, map<string,ArenaHist> & hadd, map<string,MergeInfo> & iadd, HistArena & arena )
+{
+    for( auto & h : hadd )
+    {
+        auto it = hmap.find(h.first);
+        if( it != hmap.end() && !it->second.SameBinning( h.second ) )
+        {
+            cout << "Binning of " << h.first << " differs from the sums" << endl;
+            return false;
+        }
+    }
+
+    for( auto & h : hadd )
+    {
+        auto it = hmap.find(h.first);
+        if( it == hmap.end() ) hmap.emplace( h.first, ArenaHist( arena, h.second ) );
+        else                   it->second.Add( h.second );
+        imap[h.first].Add( iadd[h.first] );
+    }
+    return true;
+}
+
+// adds hist_dl<x>nm of one file to hmap and its totals to imap
+bool AddFile( const string & file, map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, HistArena & arena )
+{
+    {
+        lock_guard<mutex> lock( OutputMutex() );
+        cout << "\t" << file << endl;
+    }
+    TFile rootfile( file.c_str() );
+    if( !rootfile.IsOpen() ) { lock_guard<mutex> lock( OutputMutex() ); cout << "File not Found: " << file << endl; return false; }
+
+    // loop over histograms
+    for( int dl = 0; dl <= 1000; dl += 100 )
+    {
+        string hname  = "hist_dl"; hname  += to_string(dl); hname  += "nm";
+
+        TH1D * h = (TH1D*)rootfile.Get( hname.c_str() );
+        if( !h ) { lock_guard<mutex> lock( OutputMutex() ); cout << "Histogram not Found: " << hname << " in " << file << endl; return false; }
+
+        // bin by bin sum, with weights the rounding depends on the order of the files
+        auto it = hmap.find(hname);
+        if( it == hmap.end() ) hmap.emplace( hname, ArenaHist( arena, *h, hname ) );
+        else if( !it->second.Add( *h ) )
+        {
+            lock_guard<mutex> lock( OutputMutex() );
+            cout << "Binning of " << hname << " in " << file << " differs" << endl;
+            return false;
+        }
+
+        // partial sums carry the totals of their inputs
+        MergeInfo info;
+        if( !ReadMergeInfo( rootfile, hname, info ) ) info = ComputeMergeInfo( *h );
+        imap[hname].Add( info );
+    }
+
+    rootfile.Close();
+
+    return true;
+}
 
-    // open output file and writing histograms
-    string output = argv[argc-1];
+// open output file and write histograms with their totals, each sum is converted
+// to TH1D just for writing
+bool WriteHistograms( string output, map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, int compression )
+{
     cout << "Output\n\t" << output << endl;
 
     TFile outfile( output.c_str(), "RECREATE" );
+    SetCompression( outfile, compression );
+    if( !outfile.IsOpen() ) { cout << "Cannot open output: " << output << endl; return false; }
+    TH1D h;
     for( int dl = 0; dl <= 1000; dl += 100 )
     {
         string hname  = "hist_dl"; hname  += to_string(dl); hname  += "nm";
-        hmap[hname].SetName(hname.c_str());
-        hmap[hname].SetTitle(hname.c_str());
-        hmap[hname].Write();
+        hmap.at(hname).CopyTo( h );
+        h.SetName(hname.c_str());
+        h.SetTitle(hname.c_str());
+        h.Write();
+        WriteMergeInfo( outfile, hname, imap[hname] );
+
+        if( !CheckMergeInfo( h, imap[hname] ) )
+            cout << "Warning: integral of " << hname << " differs from sum of inputs " << imap[hname].integral << endl;
     }
     outfile.Close();
 
-    return 0;
+    const MergeInfo & info = imap.begin()->second;
+    cout << "\tinputs " << info.ninputs << ", checksum " << hex << info.checksum << dec << endl;
+
+    return true;
+}
+
+// merges chunks of chunksize files into partial sum files, then merges the
+// partial sums chunksize at a time until at most chunksize files are left in files
+bool MergeChunked( vector<string> & files, string output, int chunksize, int compression, vector<HistArena> & warena, vector<string> & partials_all )
+{
+    int level = 0;
+    HistArena arena;
+
+    while( (int)files.size() > chunksize )
+    {
+        vector<string> partials;
+        for( size_t first = 0; first < files.size(); first += chunksize )
+        {
+            size_t last = min( first + chunksize, files.size() );
+            vector<string> chunk( files.begin() + first, files.begin() + last );
+
+            // the bins of the previous chunk are no longer needed
+            arena.Reset();
+            map<string,ArenaHist> hmap;
+            map<string,MergeInfo> imap;
+            if( !MergeFiles( chunk, hmap, imap, warena, arena ) ) return false;
+
+            string partial = PartialName( output, level, partials.size() );
+            if( !WriteHistograms( partial, hmap, imap, compression ) ) return false;
+            partials.push_back( partial );
+        }
+        cout << "Level " << level << ": " << files.size() << " files -> " << partials.size() << " partial sums" << endl;
+
+        partials_all.insert( partials_all.end(), partials.begin(), partials.end() );
+        files = partials;
+        level++;
+    }
+
+    return true;
+}
+
+// one row per dead layer histogram, isotope and location from the options
+void WriteColumnar( string filename, map<string,ArenaHist> & hmap, const Options & opts, int compression )
+{
+    ColumnarWriter writer( filename, compression );
+    if( !writer.IsOpen() ) { cout << "Cannot open columnar output: " << filename << endl; return; }
+
+    TH1D h;
+    for( int dl = 0; dl <= 1000; dl += 100 )
+    {
+        string hname  = "hist_dl"; hname  += to_string(dl); hname  += "nm";
+        SpectrumMeta meta;
+        meta.isotope   = opts.Get("--isotope");
+        meta.location  = opts.Get("--location");
+        meta.deadlayer = dl;
+        meta.component = "sum";
+        hmap.at(hname).CopyTo( h );
+        writer.Fill( h, meta );
+    }
+}
+
+// <output without .root>.part<level>_<index>.root
+string PartialName( string output, int level, int index )
+{
+    size_t ext = output.rfind(".root");
+    string base = ( ext == string::npos ) ? output : output.substr(0,ext);
+    return base + ".part" + to_string(level) + "_" + to_string(index) + ".root";
+}
+
+// set by SIGINT and SIGTERM in watch mode
+volatile sig_atomic_t gStopWatching = 0;
+
+// watch mode: every root file closed in (or moved into) the watched directories is
+// added to the sums right away unless it is in added (canonical names of the files
+// already summed), the output is rewritten at most every --interval seconds and only
+// if files were added, then the --on-update command is run and the convergence is
+// checked, with --conv-stop watching ends once the sums converged
+bool WatchDirectories( const Options & opts, DirectoryWatcher & watcher, set<string> & added, string output, map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, HistArena & arena, int compression, ConvergenceMonitor * monitor )
+{
+    regex select( opts.Get("--watch-pattern") );
+    regex partial( "\\.part[0-9]+_[0-9]+\\.root$" );
+    string command = opts.Get("--on-update");
+    string outname = CanonicalName( output );
+    auto interval = chrono::duration<double>( opts.GetDouble("--interval") );
+    auto timeout  = chrono::duration<double>( opts.GetDouble("--watch-timeout") );
+
+    gStopWatching = 0;
+    signal( SIGINT,  []( int ){ gStopWatching = 1; } );
+    signal( SIGTERM, []( int ){ gStopWatching = 1; } );
+
+    cout << "Watching " << opts.Get("--watch") << " (SIGINT/SIGTERM to stop)" << endl;
+
+    HistArena filearena; // bins of one new file, reused for every file
+    auto last_write = chrono::steady_clock::now() - interval;
+    auto last_file  = chrono::steady_clock::now();
+    bool changed = false;
+    while( !gStopWatching )
+    {
+        // sleep until the next write is due, or poll the stop flag every second
+        int wait = 1000;
+        if( changed ) wait = max( 0, (int)chrono::duration_cast<chrono::milliseconds>( last_write + interval - chrono::steady_clock::now() ).count() );
+
+        vector<string> closed;
+        if( !watcher.Wait( wait, closed ) ) return false;
+
+        for( auto & file : closed )
+        {
+            string name = file.substr( file.rfind('/') + 1 );
+            string canonical = CanonicalName( file );
+            if( !regex_search( name, select ) || regex_search( name, partial ) || canonical == outname ) continue;
+            if( added.count( canonical ) ) { cout << "Warning: " << file << " was written again, it is already in the sums and skipped" << endl; continue; }
+
+            // a broken file is skipped, it must not leave half of its histograms in the sums
+            filearena.Reset();
+            map<string,ArenaHist> hfile;
+            map<string,MergeInfo> ifile;
+            if( !AddFile( file, hfile, ifile, filearena ) || !AddSums( hmap, imap, hfile, ifile, arena ) )
+            {
+                cout << "Skipping " << file << endl;
+                continue;
+            }
+            added.insert( canonical );
+            changed = true;
+            last_file = chrono::steady_clock::now();
+        }
+
+        auto now = chrono::steady_clock::now();
+        if( changed && now - last_write >= interval )
+        {
+            if( !UpdateOutput( output, hmap, imap, compression, command ) ) return false;
+            changed = false;
+            last_write = now;
+
+            if( monitor && CheckConvergence( *monitor, hmap, imap, opts.Get("--conv-output") ) && opts.Has("--conv-stop") ) break;
+        }
+        if( timeout.count() > 0 && now - last_file >= timeout )
+        {
+            cout << "No new files for " << timeout.count() << " s" << endl;
+            break;
+        }
+    }
+
+    signal( SIGINT,  SIG_DFL );
+    signal( SIGTERM, SIG_DFL );
+
+    if( changed )
+    {
+        if( !UpdateOutput( output, hmap, imap, compression, command ) ) return false;
+        if( monitor ) CheckConvergence( *monitor, hmap, imap, opts.Get("--conv-output") );
+    }
+    return true;
+}
+
+// writes to a temporary file renamed to output, so readers never see a partial
+// output, then runs command
+bool UpdateOutput( string output, map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, int compression, string command )
+{
+    string tmp = output + ".tmp";
+    if( !WriteHistograms( tmp, hmap, imap, compression ) ) return false;
+    if( rename( tmp.c_str(), output.c_str() ) != 0 ) { cout << "Cannot rename " << tmp << " to " << output << endl; return false; }
+
+    if( !command.empty() )
+    {
+        int status = system( command.c_str() );
+        if( status != 0 ) cout << "Warning: update command returned " << status << endl;
+    }
+    return true;
+}
+
+// absolute path of the directory of path followed by the file name
+string CanonicalName( string path )
+{
+    size_t slash = path.rfind('/');
+    string dir  = ( slash == string::npos ) ? "." : path.substr( 0, slash+1 );
+    string name = ( slash == string::npos ) ? path : path.substr( slash+1 );
+
+    char resolved[PATH_MAX];
+    if( !realpath( dir.c_str(), resolved ) ) return path;
+    return string(resolved) + "/" + name;
+}
+
+// evaluates the windows of all sums, prints the status line and rewrites the status
+// file (if given) via a temporary file, true if converged
+bool CheckConvergence( ConvergenceMonitor & monitor, map<string,ArenaHist> & hmap, map<string,MergeInfo> & imap, string statusfile )
+{
+    monitor.Reset();
+    for( auto & h : hmap ) monitor.Evaluate( h.first, h.second );
+
+    long ninputs = imap.empty() ? 0 : imap.begin()->second.ninputs;
+    monitor.PrintStatus( cout, ninputs );
+
+    if( !statusfile.empty() )
+    {
+        string tmp = statusfile + ".tmp";
+        ofstream ofstatus( tmp );
+        if( !ofstatus.is_open() ) { cout << "Cannot open convergence output: " << statusfile << endl; return monitor.Converged(); }
+        monitor.Write( ofstatus, ninputs );
+        ofstatus.close();
+        if( rename( tmp.c_str(), statusfile.c_str() ) != 0 ) cout << "Cannot rename " << tmp << " to " << statusfile << endl;
+    }
+    return monitor.Converged();
+}
+
+OptionParser MakeParser()
+{
+    OptionParser parser( "HistogramCombiner", "Combine alpha spectra hist_dl<x>nm from gerda-mage-sim/alphas" );
+    parser.AddExample( "job1.root job2.root job3.root combined.root" );
+    parser.AddExample( "--input-list jobs.txt --chunk-size 500 combined.root" );
+    parser.AddExample( "--input-list jobs.txt --chunk-size 500 --chunk-index 3 partial3.root  (map stage)" );
+    parser.AddExample( "--input-list jobs.txt --conv-target 0.02 --conv-window 5200:5350 --conv-output status.txt combined.root" );
+    parser.AddExample( "--watch sim/Po210/pPlus --interval 300 --on-update './AlphaPlotter --input sum-Po210-pPlus.root' sum-Po210-pPlus.root" );
+    parser.AddPositional( "<files>", "input root files followed by the output root file", 1 );
+    parser.AddOption( "--input-list",  "-l", OptionParser::kString, "<file>", "file with one input root file per line (- for stdin)" );
+    parser.AddOption( "--chunk-size",  "-n", OptionParser::kInt,    "<int>",  "merge in chunks of n files via partial sum files (0 = all at once)", "0" );
+    parser.AddOption( "--chunk-index", "-k", OptionParser::kInt,    "<int>",  "merge only chunk k of the inputs into output (map stage)" );
+    parser.AddFlag  ( "--keep-partials", "", "do not delete the partial sum files of a chunked merge" );
+    parser.AddOption( "--columnar",    "",   OptionParser::kString, "<file>", "also write the sums as columnar tree (ColumnarWriter.h)" );
+    parser.AddOption( "--isotope",     "",   OptionParser::kString, "<name>", "isotope column of the columnar output" );
+    parser.AddOption( "--location",    "",   OptionParser::kString, "<name>", "location column of the columnar output" );
+    parser.AddOption( "--watch",       "-w", OptionParser::kString, "<dirs>", "comma separated directories, add every new file once it is closed (linux)" );
+    parser.AddOption( "--watch-pattern", "", OptionParser::kString, "<regex>", "file names added in watch mode", "\\.root$" );
+    parser.AddOption( "--interval",    "",   OptionParser::kDouble, "<s>",    "watch mode: rewrite output at most every s seconds", "60" );
+    parser.AddOption( "--on-update",   "",   OptionParser::kString, "<cmd>",  "watch mode: command run after every rewrite of the output" );
+    parser.AddOption( "--watch-timeout", "", OptionParser::kDouble, "<s>",    "watch mode: stop after s seconds without new files (0 = never)", "0" );
+    parser.AddOption( "--conv-target", "",   OptionParser::kDouble, "<rel>",  "check the convergence of the sums against this relative error" );
+    parser.AddOption( "--conv-window", "",   OptionParser::kString, "<lo:hi,...>", "energy windows in keV of the convergence check" );
+    parser.AddOption( "--conv-metric", "",   OptionParser::kString, "<metric>", "max-bin (largest bin error in window) or integral (error of window integral)", "max-bin" );
+    parser.AddOption( "--conv-every",  "",   OptionParser::kInt,    "<int>",  "check the convergence every n inputs during the merge (0 = at the end)", "0" );
+    parser.AddOption( "--conv-output", "",   OptionParser::kString, "<file>", "write the convergence status, first line converged<tab>0|1" );
+    parser.AddFlag  ( "--conv-stop",   "",   "stop adding inputs (and watching) once converged" );
+    AddCompressionOption( parser );
+    AddThreadsOption( parser );
+    return parser;
 }
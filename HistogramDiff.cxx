@@ -0,0 +1,180 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : compare two HistogramCombiner outputs bin by bin and their merge totals
+ * Compilation : g++ -O3 -std=c++1y $(root-config --cflags) HistogramDiff.cxx $(root-config --libs) -o HistogramDiff
+*/
+
+
+// c/c++
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <chrono>
+
+// root cern
+#include "TH1D.h"
+#include "TFile.h"
+#include "TKey.h"
+
+// spectra-utils
+#include "OptionParser.h"
+#include "MergeInfo.h"
+
+using namespace std;
+
+OptionParser MakeParser();
+int Run( const Options & opts );
+size_t FindDivergence( const double * a, const double * b, size_t first, size_t n, double tolerance );
+int CompareHistograms( const TH1D & ha, const TH1D & hb, double tolerance, int maxreport );
+
+int main( int argc, char* argv[] )
+{
+    // get command line arguments, one job per parameter set
+    OptionParser parser = MakeParser();
+    vector<Options> jobs;
+    int status = parser.ParseCommandLine( argc, argv, jobs );
+    if( status != 0 ) return status == OptionParser::kDone ? 0 : 1;
+
+    return RunJobs( jobs, Run );
+}
+
+int Run( const Options & opts )
+{
+    if( opts.Positional().size() != 2 ) { cout << "Need exactly two files to compare" << endl; return 1; }
+    string namea = opts.Positional()[0];
+    string nameb = opts.Positional()[1];
+    double tolerance = opts.GetDouble("--tolerance");
+    int maxreport    = opts.GetInt("--max-report");
+
+    auto start = chrono::steady_clock::now();
+
+    TFile filea( namea.c_str(), "READ" );
+    TFile fileb( nameb.c_str(), "READ" );
+    if( !filea.IsOpen() ) { cout << "File not Found: " << namea << endl; return 1; }
+    if( !fileb.IsOpen() ) { cout << "File not Found: " << nameb << endl; return 1; }
+
+    int ncompared = 0, ndiffer = 0;
+
+    // loop over histograms of the first file
+    TIter next( filea.GetListOfKeys() );
+    TKey * key;
+    while( (key = (TKey*)next()) )
+    {
+        if( string(key->GetClassName()) != "TH1D" ) continue;
+        string hname = key->GetName();
+
+        TH1D * ha = (TH1D*)filea.Get( hname.c_str() );
+        TH1D * hb = (TH1D*)fileb.Get( hname.c_str() );
+        ncompared++;
+        if( !ha || !hb ) { cout << hname << ": missing in " << nameb << endl; ndiffer++; continue; }
+
+        int ndiv = CompareHistograms( *ha, *hb, tolerance, maxreport );
+
+        // totals written by HistogramCombiner
+        MergeInfo infoa, infob;
+        bool hasa = ReadMergeInfo( filea, hname, infoa );
+        bool hasb = ReadMergeInfo( fileb, hname, infob );
+        if( hasa && hasb && !infoa.Agrees( infob, tolerance ) )
+        {
+            cout << hname << ": merge totals differ\n"
+                 << "\tinputs   " << infoa.ninputs  << " vs " << infob.ninputs  << "\n"
+                 << "\tentries  " << infoa.entries  << " vs " << infob.entries  << "\n"
+                 << "\tintegral " << infoa.integral << " vs " << infob.integral << "\n"
+                 << "\tchecksum " << hex << infoa.checksum << " vs " << infob.checksum << dec << endl;
+            ndiv++;
+        }
+        else if( hasa != hasb ) cout << hname << ": merge totals only in " << ( hasa ? namea : nameb ) << endl;
+
+        if( ndiv > 0 ) ndiffer++;
+    }
+
+    // histograms only in the second file
+    TIter nextb( fileb.GetListOfKeys() );
+    while( (key = (TKey*)nextb()) )
+    {
+        if( string(key->GetClassName()) != "TH1D" ) continue;
+        if( filea.GetKey( key->GetName() ) ) continue;
+        cout << key->GetName() << ": missing in " << namea << endl;
+        ncompared++;
+        ndiffer++;
+    }
+
+    double ms = chrono::duration<double,milli>( chrono::steady_clock::now() - start ).count();
+    cout << ncompared << " histograms compared, " << ndiffer << " differ (" << ms << " ms)" << endl;
+
+    return ndiffer == 0 ? 0 : 1;
+}
+
+// true if a and b differ by more than the relative tolerance of the larger one
+inline bool Diverges( double a, double b, double tolerance )
+{
+    double fa = fabs(a), fb = fabs(b);
+    return fabs( a - b ) > tolerance * ( fa > fb ? fa : fb );
+}
+
+// index of the first bin >= first where a and b differ by more than the relative
+// tolerance, n if there is none. Blocks are scanned with a conditional flag, a
+// reduction g++ -O3 vectorizes (an |= of the comparison or fmax is not), only a
+// block with a divergence is searched bin by bin.
+size_t FindDivergence( const double * a, const double * b, size_t first, size_t n, double tolerance )
+{
+    const size_t block = 256;
+
+    for( size_t begin = first; begin < n; begin += block )
+    {
+        size_t end = min( begin + block, n );
+
+        int diverged = 0;
+        for( size_t i = begin; i < end; i++ ) diverged = Diverges( a[i], b[i], tolerance ) ? 1 : diverged;
+        if( !diverged ) continue;
+
+        for( size_t i = begin; i < end; i++ )
+            if( Diverges( a[i], b[i], tolerance ) ) return i;
+    }
+
+    return n;
+}
+
+// prints the first maxreport divergences, returns the number found
+int CompareHistograms( const TH1D & ha, const TH1D & hb, double tolerance, int maxreport )
+{
+    string hname = ha.GetName();
+    int nbins = ha.GetNbinsX();
+
+    if( nbins != hb.GetNbinsX() ||
+        ha.GetXaxis()->GetXmin() != hb.GetXaxis()->GetXmin() ||
+        ha.GetXaxis()->GetXmax() != hb.GetXaxis()->GetXmax() )
+    {
+        cout << hname << ": binning differs" << endl;
+        return 1;
+    }
+
+    // contents including under- and overflow
+    const double * a = ha.GetArray();
+    const double * b = hb.GetArray();
+    size_t n = nbins + 2;
+
+    int ndiv = 0;
+    for( size_t i = FindDivergence( a, b, 0, n, tolerance ); i < n; i = FindDivergence( a, b, i+1, n, tolerance ) )
+    {
+        if( ndiv < maxreport )
+            cout << hname << ": bin " << i << " (" << ha.GetXaxis()->GetBinCenter(i) << ") "
+                 << a[i] << " vs " << b[i] << endl;
+        ndiv++;
+    }
+    if( ndiv > maxreport ) cout << hname << ": " << ndiv - maxreport << " more bins differ" << endl;
+
+    return ndiv;
+}
+
+OptionParser MakeParser()
+{
+    OptionParser parser( "HistogramDiff", "Compare two merged outputs bin by bin, exit code 1 if they differ" );
+    parser.AddExample( "combined-flat.root combined-chunked.root" );
+    parser.AddPositional( "<files>", "the two root files to compare", 2 );
+    parser.AddOption( "--tolerance",  "-t", OptionParser::kDouble, "<double>", "relative tolerance per bin", "0" );
+    parser.AddOption( "--max-report", "-m", OptionParser::kInt,    "<int>",    "number of divergent bins reported per histogram", "10" );
+    return parser;
+}
@@ -0,0 +1,122 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : running totals of merged histograms to verify that every input
+ *               was counted exactly once, stored in the merge_info directory
+ *               of HistogramCombiner outputs
+*/
+
+#ifndef SPECTRA_UTILS_MERGEINFO_H
+#define SPECTRA_UTILS_MERGEINFO_H
+
+// c/c++
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <string>
+
+// root cern
+#include "TH1D.h"
+#include "TDirectory.h"
+#include "TParameter.h"
+
+struct MergeInfo
+{
+    Long64_t  ninputs  = 0; // number of original (leaf) inputs
+    double    entries  = 0.;
+    double    integral = 0.;
+    ULong64_t checksum = 0; // sum of content hashes of the leaf inputs, order independent
+
+    void Add( const MergeInfo & other )
+    {
+        ninputs  += other.ninputs;
+        entries  += other.entries;
+        integral += other.integral;
+        checksum += other.checksum; // wraps mod 2^64, double counting does not cancel
+    }
+
+    // same inputs (count and checksum, exact) and totals within the relative tolerance,
+    // weighted totals depend on the order in which partial sums were added
+    bool Agrees( const MergeInfo & other, double tolerance ) const
+    {
+        auto close = [tolerance]( double a, double b ) { return std::fabs( a - b ) <= tolerance * std::max( std::fabs(a), std::fabs(b) ); };
+        return ninputs == other.ninputs && checksum == other.checksum &&
+               close( entries, other.entries ) && close( integral, other.integral );
+    }
+};
+
+// FNV-1a over the binning and all bin contents including under- and overflow
+inline ULong64_t HistogramChecksum( const TH1D & h )
+{
+    ULong64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash]( const void * data, size_t n )
+    {
+        const unsigned char * p = (const unsigned char*) data;
+        for( size_t i = 0; i < n; i++ ) { hash ^= p[i]; hash *= 1099511628211ULL; }
+    };
+
+    int nbins = h.GetNbinsX();
+    double xmin = h.GetXaxis()->GetXmin(), xmax = h.GetXaxis()->GetXmax();
+    mix( &nbins, sizeof(nbins) ); mix( &xmin, sizeof(xmin) ); mix( &xmax, sizeof(xmax) );
+    mix( h.GetArray(), sizeof(double) * (nbins+2) );
+
+    return hash;
+}
+
+// totals of a single original input
+inline MergeInfo ComputeMergeInfo( const TH1D & h )
+{
+    MergeInfo info;
+    info.ninputs  = 1;
+    info.entries  = h.GetEntries();
+    info.integral = h.Integral();
+    info.checksum = HistogramChecksum( h );
+    return info;
+}
+
+// reads totals for histogram hname, false if dir holds no merge_info (not a merge output)
+inline bool ReadMergeInfo( TDirectory & dir, const std::string & hname, MergeInfo & info )
+{
+    TDirectory * mdir = dir.GetDirectory("merge_info");
+    if( !mdir ) return false;
+
+    std::unique_ptr<TParameter<Long64_t>> ninputs ( dynamic_cast<TParameter<Long64_t>*>( mdir->Get( (hname + "_ninputs" ).c_str() ) ) );
+    std::unique_ptr<TParameter<Long64_t>> checksum( dynamic_cast<TParameter<Long64_t>*>( mdir->Get( (hname + "_checksum").c_str() ) ) );
+    std::unique_ptr<TParameter<double>>   entries ( dynamic_cast<TParameter<double>*>  ( mdir->Get( (hname + "_entries" ).c_str() ) ) );
+    std::unique_ptr<TParameter<double>>   integral( dynamic_cast<TParameter<double>*>  ( mdir->Get( (hname + "_integral").c_str() ) ) );
+    if( !ninputs || !checksum || !entries || !integral ) return false;
+
+    Long64_t sum = checksum->GetVal();
+    info.ninputs  = ninputs->GetVal();
+    info.entries  = entries->GetVal();
+    info.integral = integral->GetVal();
+    std::memcpy( &info.checksum, &sum, sizeof(sum) );
+    return true;
+}
+
+// writes totals for histogram hname into dir/merge_info
+inline void WriteMergeInfo( TDirectory & dir, const std::string & hname, const MergeInfo & info )
+{
+    TDirectory * mdir = dir.GetDirectory("merge_info");
+    if( !mdir ) mdir = dir.mkdir("merge_info");
+
+    Long64_t sum;
+    std::memcpy( &sum, &info.checksum, sizeof(sum) );
+
+    mdir->cd();
+    TParameter<Long64_t>( (hname + "_ninputs" ).c_str(), info.ninputs  ).Write();
+    TParameter<Long64_t>( (hname + "_checksum").c_str(), sum           ).Write();
+    TParameter<double>  ( (hname + "_entries" ).c_str(), info.entries  ).Write();
+    TParameter<double>  ( (hname + "_integral").c_str(), info.integral ).Write();
+    dir.cd();
+}
+
+// merged integral has to match the sum of input integrals up to rounding
+inline bool CheckMergeInfo( const TH1D & h, const MergeInfo & info )
+{
+    double integral = h.Integral();
+    return std::fabs( integral - info.integral ) <= 1e-9 * std::fmax( 1., std::fabs(info.integral) );
+}
+
+#endif
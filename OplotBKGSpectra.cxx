@@ -11,58 +11,65 @@
 #include <map>
 #include <string>
 #include <fstream>
+#include <mutex>
 
 // cern root
 #include "TH1D.h"
+#include "TH2D.h"
 #include "TFile.h"
 #include "TCanvas.h"
 #include "TStyle.h"
 #include "TROOT.h"
 #include "TLegend.h"
 
+// spectra-utils
+#include "OptionParser.h"
+#include "OutputFile.h"
+#include "ParallelIO.h"
+#include "DetectorGroups.h"
+#include "HistArena.h"
+
 using namespace std;
 
-void Usage();
+OptionParser MakeParser();
+int Run( const Options & opts );
 void rootlogon( string style = "short" );
 
 int main( int argc, char * argv[] )
 {
     rootlogon();
 
-    // get command line arguments
-    vector<string> args;
-    for ( int i = 0; i < argc; ++i ) args.push_back( argv[i] );
+    // get command line arguments, one job per parameter set
+    OptionParser parser = MakeParser();
+    vector<Options> jobs;
+    int status = parser.ParseCommandLine( argc, argv, jobs );
+    if( status != 0 ) return status == OptionParser::kDone ? 0 : 1;
 
-    // user requested help or made input error
-    if ( argc < 2 ) { Usage(); return 1; }
-    else if ( find(args.begin(), args.end(), "--help") != args.end() ||
-              find(args.begin(), args.end(), "-h")     != args.end() ) { Usage(); return 1; }
+    return RunJobs( jobs, Run );
+}
 
+int Run( const Options & opts )
+{
     // check OPTIONS
-    // get input filelist
-    string filelistname;
-    auto result = find( args.begin(), args.end(), "--input" );
-    if ( result != args.end() ) filelistname = *(result+1);
-    else { Usage(); return 1; }
-    // common name of histogram to plot
-    string hname;
-    result = find( args.begin(), args.end(), "--histo" );
-    if ( result != args.end() ) hname = *(result+1);
-    else { Usage(); return 1; }
+    string filelistname = opts.Get("--input");
+    string hname        = opts.Get("--histo");
+    string outname      = opts.Get("--output");
+    int compression;
+    if( !GetCompression( opts, compression ) ) return 1;
 
     // read list of files in a vector
     string directory, filename;
     vector<string> filelist;
 
     ifstream iflist( filelistname );
-    iflist >> directory >> filename;
+    if( !iflist.is_open() ) { cout << "File list not Found: " << filelistname << endl; return 1; }
+    iflist >> directory;
     cout << directory << endl;
 
-    while( !iflist.eof() )
+    while( iflist >> filename )
     {
         cout << "\t" << filename << endl;
         filelist.push_back(filename);
-        iflist >> filename;
     }
 
     // define color seuqence
@@ -77,14 +84,39 @@ int main( int argc, char * argv[] )
       "GD89A", "ANG1",  "GTF112", "GTF32", "GTF45"
     };
 
+    // read the histograms, every worker opens its own files and copies the bins to its arena
+    int nthreads = GetThreads( opts );
+    vector<HistArena> arenas( nthreads );
+    vector<ArenaHist> hfile( filelist.size() );
+    bool ok = ParallelFor( filelist.size(), nthreads, [&]( int worker, size_t ci )
+    {
+        string filename = filelist[ci];
+        string cname = hname; cname += "_clone"; cname += to_string(ci);
+
+        // get hist
+        TFile irfile( (directory+filename).c_str(), "READ");
+        TH1D * h = irfile.IsOpen() ? (TH1D*)irfile.Get(hname.c_str()) : nullptr;
+        {
+            lock_guard<mutex> lock( OutputMutex() );
+            if(!irfile.IsOpen()) { cout << "File not Found: " << directory << filename << endl; return false; }
+            else                   cout << "File Found: " << directory << filename << endl;
+            if(!h) { cout << "Histogram not Found: " << hname << endl; return false; }
+        }
+        hfile[ci] = ArenaHist( arenas[worker], *h, cname );
+
+        // close file
+        irfile.Close();
+        return true;
+    } );
+    if( !ok ) return 1;
+
     // save histograms
-    map<string,TH1D> histograms;
+    map<string,ArenaHist> histograms;
 
-    // plot the histograms
-    int ci = 0;
-    for( auto filename : filelist )
+    for( size_t ci = 0; ci < filelist.size(); ci++ )
     {
         // parse filename
+        string filename = filelist[ci];
         int ind1 = filename.rfind("-");
         int ind2 = filename.rfind(".root");
         int ind3 = filename.find("-");
@@ -93,18 +125,50 @@ int main( int argc, char * argv[] )
         location.replace(location.find("-"),1,":");
         string label = isotope; label += ":"; label += location;
 
-        string cname = hname; cname += "_clone"; cname += to_string(ci);
-
-        // get hist
-        TFile irfile( (directory+filename).c_str(), "READ");
-        if(!irfile.IsOpen()) cout << "File not Found: " << directory << filename << endl;
-        else                 cout << "File Found: " << directory << filename << endl;
+        histograms[label] = move( hfile[ci] );
+    }
 
-        histograms[label] = *(TH1D*)irfile.Get(hname.c_str())->Clone(cname.c_str());
+    // sums over detector groups for all histograms in one pass (optional)
+    TH2D hgroups;
+    if( opts.Has("--groups") )
+    {
+        DetectorGroups groups( det );
+        if(      opts.Get("--groups") == "type" ) groups.AddTypeGroups();
+        else if( !groups.ReadGroups( opts.Get("--groups") ) ) return 1;
 
-        // close file
-        irfile.Close();
-        ci++;
+        vector<string> labels;
+        vector<const double*> contents;
+        for( auto & hist : histograms )
+        {
+            if( hist.second.GetNbinsX() < (int)det.size() ) { cout << "Histogram " << hist.first << " has less bins than channels" << endl; return 1; }
+            labels.push_back( hist.first );
+            contents.push_back( hist.second.GetArray()+1 );
+        }
+        vector<double> sums = groups.Sum( contents );
+        size_t ngr = groups.GetNgroups();
+
+        // files x groups matrix as root histogram and tab separated table
+        hgroups = TH2D( "group_sums", "sum over detector groups", ngr, 0, ngr, labels.size(), 0, labels.size() );
+        ofstream ofgroups( outname + "-groups.txt" );
+        ofgroups << "pdf";
+        for( size_t g = 0; g < ngr; g++ )
+        {
+            ofgroups << "\t" << groups.GetGroups()[g];
+            hgroups.GetXaxis()->SetBinLabel( g+1, groups.GetGroups()[g].c_str() );
+        }
+        ofgroups << "\n";
+        for( size_t f = 0; f < labels.size(); f++ )
+        {
+            ofgroups << labels[f];
+            hgroups.GetYaxis()->SetBinLabel( f+1, labels[f].c_str() );
+            for( size_t g = 0; g < ngr; g++ )
+            {
+                ofgroups << "\t" << sums[f*ngr+g];
+                hgroups.SetBinContent( g+1, f+1, sums[f*ngr+g] );
+            }
+            ofgroups << "\n";
+        }
+        cout << "Group sums of " << labels.size() << " pdfs written to " << outname << "-groups.txt" << endl;
     }
 
     // create canvas
@@ -113,57 +177,67 @@ int main( int argc, char * argv[] )
     TLegend l(0.1,0.7,0.5,0.97);
     l.SetMargin(0.2);
 
-    ci = 0;
+    // the pdfs are converted to TH1D only for drawing and writing
+    vector<TH1D> hdraw( histograms.size() );
+    int ci = 0;
     for( auto & hist : histograms )
     {
+        TH1D & h = hdraw[ci];
+        hist.second.CopyTo( h );
+
         // set x-axis labels
-        int nbins = hist.second.GetNbinsX();
+        int nbins = h.GetNbinsX();
         for (int b = 1; b <= nbins; ++b) {
-            hist.second.GetXaxis()->SetBinLabel(b, det[b-1].c_str());
+            h.GetXaxis()->SetBinLabel(b, det[b-1].c_str());
         }
-        hist.second.GetXaxis()->LabelsOption("v");
-        hist.second.GetYaxis()->SetTitle("a.u.");
+        h.GetXaxis()->LabelsOption("v");
+        h.GetYaxis()->SetTitle("a.u.");
 
         // normalize
-        hist.second.Scale(1./hist.second.Integral());
+        h.Scale(1./h.Integral());
 
         // set histogram attributes
-        hist.second.SetLineColor( color_sequence.at(ci)+1 );
-        hist.second.SetLineWidth(2);
+        h.SetLineColor( color_sequence.at(ci % color_sequence.size())+1 );
+        h.SetLineWidth(2);
 
         // add legend entry
-        l.AddEntry(&hist.second,hist.first.c_str(),"l");
+        l.AddEntry(&h,hist.first.c_str(),"l");
 
         if(ci == 0)
         {
-            hist.second.GetYaxis()->SetRangeUser(0,0.138);
-            hist.second.DrawClone("hist");
+            h.GetYaxis()->SetRangeUser(0,0.138);
+            h.DrawClone("hist");
         }
-        else        hist.second.DrawClone("histsame");
+        else        h.DrawClone("histsame");
 
         ci++;
     }
 
     // draw legend
     l.Draw();
-    c.Print("test.png");
-    c.Print("test.pdf");
+    c.Print( (outname + ".png").c_str() );
+    c.Print( (outname + ".pdf").c_str() );
 
-    TFile outfile( "test.root", "RECREATE" );
+    TFile outfile( (outname + ".root").c_str(), "RECREATE" );
+    SetCompression( outfile, compression );
     c.Write();
-    for( auto hist : histograms ) hist.second.Write();
+    for( auto & h : hdraw ) h.Write();
+    if( opts.Has("--groups") ) hgroups.Write();
     outfile.Close();
 
     return 0;
 }
 
-void Usage()
+OptionParser MakeParser()
 {
-    cout << "USAGE   : ./OplotBKGSpectra \n\n";
-    cout << "OPTIONS : \n\n";
-    cout << "       required:   --input <filelist>  : txt file with directory and list of files\n";
-    cout << "                   --histo <histoname> : name of histogram to plot\n\n";
-    return;
+    OptionParser parser( "OplotBKGSpectra", "Plot simulated spectra one over the other" );
+    parser.AddOption( "--input",  "", OptionParser::kString, "<filelist>",  "txt file with directory and list of files", "", true );
+    parser.AddOption( "--histo",  "", OptionParser::kString, "<histoname>", "name of histogram to plot", "", true );
+    parser.AddOption( "--output", "", OptionParser::kString, "<basename>",  "basename of png, pdf and root output", "test" );
+    parser.AddOption( "--groups", "", OptionParser::kString, "<file|type>", "sum channels over detector groups: file with lines <group> <detector>... or type" );
+    AddCompressionOption( parser );
+    AddThreadsOption( parser );
+    return parser;
 }
 
 // this sets the GERDA default style for spectra plots
@@ -0,0 +1,323 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : declarative command line option schema shared by all tools
+ *               header only, no extra compilation unit needed
+*/
+
+#ifndef SPECTRA_UTILS_OPTIONPARSER_H
+#define SPECTRA_UTILS_OPTIONPARSER_H
+
+// c/c++
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <cctype>
+
+// parsed values of one parameter set (one job)
+class Options
+{
+  public:
+    // true if option was given explicitly (or is a flag that was set)
+    bool Has( const std::string & name ) const { return fValues.count(name) > 0; }
+
+    // value of option, default value of the schema if not given
+    std::string Get( const std::string & name ) const
+    {
+        auto it = fValues.find(name);
+        if( it != fValues.end() ) return it->second;
+        auto dt = fDefaults.find(name);
+        if( dt != fDefaults.end() ) return dt->second;
+        throw std::out_of_range( "option " + name + " not in schema" );
+    }
+    int    GetInt   ( const std::string & name ) const { return std::stoi( Get(name) ); }
+    double GetDouble( const std::string & name ) const { return std::stod( Get(name) ); }
+
+    const std::vector<std::string> & Positional() const { return fPositional; }
+
+  private:
+    friend class OptionParser;
+    std::map<std::string,std::string> fValues;
+    std::map<std::string,std::string> fDefaults;
+    std::vector<std::string>          fPositional;
+};
+
+class OptionParser
+{
+  public:
+    enum Type { kString, kInt, kDouble, kFlag };
+
+    // ParseCommandLine status after --help or --print-schema, nothing to run
+    static const int kDone = 2;
+
+    OptionParser( const std::string & program, const std::string & description ) :
+        fProgram(program), fDescription(description) {}
+
+    // declare an option with value, alias may be empty
+    void AddOption( const std::string & name, const std::string & alias, Type type,
+                    const std::string & metavar, const std::string & help,
+                    const std::string & defval = "", bool required = false )
+    {
+        fSpecs.push_back( { name, alias, type, metavar, help, defval, required } );
+        fIndex[name] = fSpecs.size()-1;
+        if( !alias.empty() ) fIndex[alias] = fSpecs.size()-1;
+    }
+
+    // declare an option without value
+    void AddFlag( const std::string & name, const std::string & alias, const std::string & help )
+    {
+        AddOption( name, alias, kFlag, "", help );
+    }
+
+    // declare positional arguments, at least nmin are required
+    void AddPositional( const std::string & metavar, const std::string & help, int nmin = 0 )
+    {
+        fPosMetavar = metavar; fPosHelp = help; fPosMin = nmin;
+    }
+
+    // example line printed in Usage
+    void AddExample( const std::string & example ) { fExamples.push_back( example ); }
+
+    // parse one parameter set, returns false and sets error on failure
+    // later occurrences of an option override earlier ones
+    bool Parse( const std::vector<std::string> & args, Options & opts, std::string & error ) const
+    {
+        for( auto & spec : fSpecs ) opts.fDefaults[spec.name] = spec.defval;
+
+        for( size_t i = 0; i < args.size(); i++ )
+        {
+            const std::string & arg = args[i];
+
+            if( !IsOption(arg) )
+            {
+                if( fPosMetavar.empty() ) { error = "unexpected argument " + arg; return false; }
+                opts.fPositional.push_back( arg );
+                continue;
+            }
+
+            auto it = fIndex.find( arg );
+            if( it == fIndex.end() ) { error = "unknown option " + arg; return false; }
+            const Spec & spec = fSpecs[it->second];
+
+            if( spec.type == kFlag ) { opts.fValues[spec.name] = "1"; continue; }
+
+            if( i+1 >= args.size() ) { error = "option " + arg + " requires a value " + spec.metavar; return false; }
+            const std::string & value = args[++i];
+
+            if( !CheckType( spec.type, value ) )
+            {
+                error = "option " + arg + " expects " + TypeName(spec.type) + ", got " + value;
+                return false;
+            }
+            opts.fValues[spec.name] = value;
+        }
+
+        for( auto & spec : fSpecs )
+            if( spec.required && !opts.Has(spec.name) ) { error = "missing required option " + spec.name; return false; }
+
+        if( (int)opts.fPositional.size() < fPosMin )
+        {
+            error = "need at least " + std::to_string(fPosMin) + " " + fPosMetavar + " arguments";
+            return false;
+        }
+
+        return true;
+    }
+
+    // parse the command line into a list of jobs
+    // --jobs <file> : every non empty line of file is one parameter set, options
+    //                 given on the command line act as defaults for all lines
+    // returns 0 on success, kDone if only help or the schema was printed, 1 if
+    // the input was wrong
+    int ParseCommandLine( int argc, char * argv[], std::vector<Options> & jobs ) const
+    {
+        std::vector<std::string> args;
+        std::string jobfile;
+        for( int i = 1; i < argc; ++i )
+        {
+            std::string arg = argv[i];
+            if( arg == "--help" || arg == "-h" ) { Usage(); return kDone; }
+            if( arg == "--print-schema" )        { PrintSchema(); return kDone; }
+            if( arg == "--jobs" )
+            {
+                if( i+1 >= argc ) { std::cout << "option --jobs requires a value <file>\n"; return 1; }
+                jobfile = argv[++i];
+                continue;
+            }
+            args.push_back( arg );
+        }
+
+        if( jobfile.empty() )
+        {
+            if( args.empty() && (fPosMin > 0 || HasRequired()) ) { Usage(); return 1; }
+            return AddJob( args, jobs, "" ) ? 0 : 1;
+        }
+
+        std::ifstream ifjobs( jobfile );
+        if( !ifjobs.is_open() ) { std::cout << "Job file not found: " << jobfile << std::endl; return 1; }
+
+        std::string line;
+        int lineno = 0;
+        while( std::getline( ifjobs, line ) )
+        {
+            lineno++;
+            auto hash = line.find('#');
+            if( hash != std::string::npos ) line.erase(hash);
+
+            std::vector<std::string> jobargs = args;
+            std::istringstream tokens( line );
+            std::string token;
+            size_t nbase = jobargs.size();
+            while( tokens >> token ) jobargs.push_back( token );
+            if( jobargs.size() == nbase ) continue;
+
+            if( !AddJob( jobargs, jobs, jobfile + ":" + std::to_string(lineno) + ": " ) ) return 1;
+        }
+
+        if( jobs.empty() ) { std::cout << "No jobs found in " << jobfile << std::endl; return 1; }
+
+        return 0;
+    }
+
+    // human readable help generated from the schema
+    void Usage() const
+    {
+        std::cout << fDescription << "\n\n";
+        std::cout << "USAGE   : ./" << fProgram << " [OPTIONS]";
+        if( !fPosMetavar.empty() ) std::cout << " " << fPosMetavar << "...";
+        std::cout << "\n";
+        std::cout << "          ./" << fProgram << " [OPTIONS] --jobs <file>\n\n";
+        for( auto & ex : fExamples ) std::cout << "EXAMPLE : ./" << fProgram << " " << ex << "\n";
+        if( !fExamples.empty() ) std::cout << "\n";
+        std::cout << "OPTIONS :\n\n";
+
+        if( !fPosMetavar.empty() )
+            std::cout << "    " << Pad( fPosMetavar + "...", 32 ) << " : " << fPosHelp << "\n";
+
+        for( int required = 1; required >= 0; required-- )
+        {
+            bool first = true;
+            for( auto & spec : fSpecs )
+            {
+                if( spec.required != (bool)required ) continue;
+                std::string head = first ? (required ? "required : " : "optional : ") : "           ";
+                first = false;
+                std::string name = spec.name;
+                if( !spec.alias.empty() ) name += " " + spec.alias;
+                if( !spec.metavar.empty() ) name += " " + spec.metavar;
+                std::cout << "    " << head << Pad( name, 32 ) << " : " << spec.help;
+                if( !spec.defval.empty() ) std::cout << " (default " << spec.defval << ")";
+                std::cout << "\n";
+            }
+        }
+        std::cout << "\n";
+        std::cout << "    batch    : " << Pad( "--jobs <file>", 32 ) << " : one parameter set per line, command line\n"
+                  << "               " << Pad( "", 32 )              << "   options are defaults for every line\n";
+        std::cout << "               " << Pad( "--print-schema", 32 ) << " : print option schema as tab separated table\n";
+        std::cout << "               " << Pad( "--help -h", 32 )      << " : print this help\n";
+    }
+
+    // machine readable schema, one option per line:
+    // name alias type required default help
+    void PrintSchema() const
+    {
+        for( auto & spec : fSpecs )
+            std::cout << spec.name << "\t" << (spec.alias.empty() ? "-" : spec.alias) << "\t"
+                      << TypeName(spec.type) << "\t" << spec.required << "\t"
+                      << (spec.defval.empty() ? "-" : spec.defval) << "\t" << spec.help << "\n";
+        if( !fPosMetavar.empty() )
+            std::cout << fPosMetavar << "\t-\tpositional\t" << (fPosMin > 0) << "\t-\t" << fPosHelp << "\n";
+    }
+
+  private:
+    struct Spec
+    {
+        std::string name, alias;
+        Type        type;
+        std::string metavar, help, defval;
+        bool        required;
+    };
+
+    bool AddJob( const std::vector<std::string> & args, std::vector<Options> & jobs, const std::string & where ) const
+    {
+        Options opts; std::string error;
+        if( !Parse( args, opts, error ) )
+        {
+            std::cout << where << error << "\n\n";
+            Usage();
+            return false;
+        }
+        jobs.push_back( opts );
+        return true;
+    }
+
+    bool HasRequired() const
+    {
+        for( auto & spec : fSpecs ) if( spec.required ) return true;
+        return false;
+    }
+
+    // options start with '-', negative numbers do not
+    static bool IsOption( const std::string & arg )
+    {
+        if( arg.size() < 2 || arg[0] != '-' ) return false;
+        return !( isdigit(arg[1]) || arg[1] == '.' );
+    }
+
+    static bool CheckType( Type type, const std::string & value )
+    {
+        try
+        {
+            size_t pos = 0;
+            if(      type == kInt    ) { std::stoi( value, &pos ); return pos == value.size(); }
+            else if( type == kDouble ) { std::stod( value, &pos ); return pos == value.size(); }
+        }
+        catch( std::exception & ) { return false; }
+        return true;
+    }
+
+    static std::string TypeName( Type type )
+    {
+        if(      type == kInt    ) return "int";
+        else if( type == kDouble ) return "double";
+        else if( type == kFlag   ) return "flag";
+        return "string";
+    }
+
+    static std::string Pad( const std::string & s, size_t width )
+    {
+        return s.size() >= width ? s : s + std::string( width - s.size(), ' ' );
+    }
+
+    std::string fProgram, fDescription;
+    std::vector<Spec> fSpecs;
+    std::unordered_map<std::string,size_t> fIndex;
+    std::vector<std::string> fExamples;
+    std::string fPosMetavar, fPosHelp;
+    int fPosMin = 0;
+};
+
+// run every job in the same process, a failing job does not stop the others
+// returns 0 if all jobs succeeded
+inline int RunJobs( const std::vector<Options> & jobs, std::function<int(const Options&)> run )
+{
+    int failed = 0;
+    for( size_t j = 0; j < jobs.size(); j++ )
+    {
+        if( jobs.size() > 1 ) std::cout << "Job " << j+1 << "/" << jobs.size() << std::endl;
+        int status = 1;
+        try                             { status = run( jobs[j] ); }
+        catch( std::exception & e )     { std::cout << "Error: " << e.what() << std::endl; }
+        if( status != 0 ) failed++;
+    }
+    if( jobs.size() > 1 ) std::cout << "Jobs done: " << jobs.size()-failed << " succeeded, " << failed << " failed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : compression settings of written root files, shared by all tools
+*/
+
+#ifndef SPECTRA_UTILS_OUTPUTFILE_H
+#define SPECTRA_UTILS_OUTPUTFILE_H
+
+// c/c++
+#include <iostream>
+#include <string>
+#include <map>
+
+// root cern
+#include "TFile.h"
+
+// spectra-utils
+#include "OptionParser.h"
+
+// converts "<algorithm>[:<level>]" to root compression settings
+// algorithm * 100 + level, see ROOT::CompressionSettings
+// algorithms: none, zlib, lzma, lz4, zstd; level 1 (fast) to 9 (small)
+// "default" keeps the default of the root version in use (-1)
+inline bool ParseCompression( const std::string & spec, int & settings )
+{
+    const std::map<std::string,int> algorithms = { {"zlib",1}, {"lzma",2}, {"lz4",4}, {"zstd",5} };
+
+    std::string name = spec.substr( 0, spec.find(':') );
+    if( name == "default" ) { settings = -1; return true; }
+    if( name == "none" )    { settings = 0;  return true; }
+
+    auto it = algorithms.find( name );
+    if( it == algorithms.end() ) { std::cout << "Unknown compression algorithm: " << name << std::endl; return false; }
+
+    int level = 1;
+    if( name.size() < spec.size() )
+    {
+        std::string slevel = spec.substr( name.size()+1 );
+        if( slevel.size() != 1 || slevel[0] < '1' || slevel[0] > '9' )
+        {
+            std::cout << "Compression level has to be 1-9: " << spec << std::endl;
+            return false;
+        }
+        level = slevel[0] - '0';
+    }
+
+    settings = it->second * 100 + level;
+    return true;
+}
+
+inline void AddCompressionOption( OptionParser & parser )
+{
+    parser.AddOption( "--compression", "", OptionParser::kString, "<alg:level>",
+                      "compression of written root files (default, none, zlib, lzma, lz4, zstd), level 1-9", "default" );
+}
+
+// compression settings of the --compression option of opts
+inline bool GetCompression( const Options & opts, int & settings )
+{
+    return ParseCompression( opts.Get("--compression"), settings );
+}
+
+// applies to all objects written to file afterwards
+inline void SetCompression( TFile & file, int settings )
+{
+    if( settings >= 0 ) file.SetCompressionSettings( settings );
+}
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : worker threads reading root files in parallel, every worker
+ *               opens its own TFile handles and objects read from a file stay
+ *               owned by that file, shared by all tools
+*/
+
+#ifndef SPECTRA_UTILS_PARALLELIO_H
+#define SPECTRA_UTILS_PARALLELIO_H
+
+// c/c++
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// root cern
+#include "TROOT.h"
+
+// spectra-utils
+#include "OptionParser.h"
+
+inline void AddThreadsOption( OptionParser & parser )
+{
+    parser.AddOption( "--threads", "-j", OptionParser::kInt, "<int>", "number of worker threads reading files (0 = all cores)", "1" );
+}
+
+// number of worker threads of the --threads option of opts
+inline int GetThreads( const Options & opts )
+{
+    int nthreads = opts.GetInt("--threads");
+    if( nthreads <= 0 ) nthreads = std::thread::hardware_concurrency();
+    return nthreads > 0 ? nthreads : 1;
+}
+
+// makes root thread aware, called once before the first worker starts. Implicit MT
+// is not enabled, the workers read histograms only and its pool would run nthreads
+// more threads next to them
+inline void EnableThreading( int nthreads )
+{
+    static bool enabled = false;
+    if( enabled || nthreads <= 1 ) return;
+
+    ROOT::EnableThreadSafety();
+    enabled = true;
+}
+
+// serialises output of worker threads
+inline std::mutex & OutputMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+// calls work( worker, index ) for every index in [0,n) on nthreads workers.
+// Indices are handed out in order from a shared counter, so slow files do not
+// block a fixed partition. Stops handing out indices once work returned false.
+// Returns false if any call failed.
+inline bool ParallelFor( size_t n, int nthreads, std::function<bool(int,size_t)> work )
+{
+    if( nthreads <= 1 || n <= 1 )
+    {
+        for( size_t i = 0; i < n; i++ ) if( !work( 0, i ) ) return false;
+        return true;
+    }
+
+    EnableThreading( nthreads );
+
+    std::atomic<size_t> next( 0 );
+    std::atomic<bool>   ok( true );
+    std::vector<std::thread> workers;
+    for( int w = 0; w < nthreads && w < (int)n; w++ )
+    {
+        workers.emplace_back( [&, w]()
+        {
+            for( size_t i = next++; i < n && ok; i = next++ )
+                if( !work( w, i ) ) ok = false;
+        } );
+    }
+    for( auto & worker : workers ) worker.join();
+
+    return ok;
+}
+
+// calls work( worker, index ) for every index in [0,n) on nthreads workers,
+// worker w gets the fixed contiguous block [w*n/nthreads,(w+1)*n/nthreads) in
+// order. Per worker results then depend on n and nthreads only, not on timing,
+// e.g. floating point sums reduced in worker order. Stops once work returned
+// false. Returns false if any call failed.
+inline bool ParallelForBlocks( size_t n, int nthreads, std::function<bool(int,size_t)> work )
+{
+    if( nthreads <= 1 || n <= 1 )
+    {
+        for( size_t i = 0; i < n; i++ ) if( !work( 0, i ) ) return false;
+        return true;
+    }
+
+    EnableThreading( nthreads );
+
+    std::atomic<bool> ok( true );
+    std::vector<std::thread> workers;
+    for( int w = 0; w < nthreads; w++ )
+    {
+        size_t first = n * w / nthreads, last = n * ( w + 1 ) / nthreads;
+        if( first == last ) continue;
+        workers.emplace_back( [&, w, first, last]()
+        {
+            for( size_t i = first; i < last && ok; i++ )
+                if( !work( w, i ) ) ok = false;
+        } );
+    }
+    for( auto & worker : workers ) worker.join();
+
+    return ok;
+}
+
+#endif
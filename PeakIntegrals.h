@@ -0,0 +1,233 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : window integrals in O(1) from prefix sums and a finder for the
+ *               Po210, Ra226 and Rn222 alpha peaks (and the Rn222 daughters)
+*/
+
+#ifndef SPECTRA_UTILS_PEAKINTEGRALS_H
+#define SPECTRA_UTILS_PEAKINTEGRALS_H
+
+// c/c++
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// alpha lines in keV, ordered by energy
+struct AlphaLine
+{
+    std::string name;
+    double      energy;
+};
+
+const std::vector<AlphaLine> kAlphaLines =
+{
+    { "Ra226", 4784.3 }, { "Po210", 5304.3 }, { "Rn222", 5489.5 }, { "Po218", 6002.4 }, { "Po214", 7686.8 }
+};
+
+struct PeakInfo
+{
+    std::string line;
+    bool   found    = false;
+    double position = 0.; // keV, center of the maximum bin (PeakCandidate)
+    double shift    = 0.; // keV, line energy - position (dead layer energy loss)
+    double fwhm     = 0.; // keV, half maximum crossings interpolated linearly
+    double counts   = 0.; // in position +- fwhm
+    double tail     = 0.; // fraction of counts in [position - tail window, position - fwhm]
+};
+
+// cumulative sums of a spectrum, integral of any energy window in O(1)
+class PrefixSum
+{
+  public:
+    // contents are the nbins bins without under- and overflow, edges the nbins+1 bin edges
+    PrefixSum( const double * contents, const double * edges, int nbins ) :
+        fNbins(nbins), fEdges( edges, edges + nbins + 1 ), fCumulative( nbins + 1, 0. )
+    {
+        for( int b = 0; b < nbins; b++ ) fCumulative[b+1] = fCumulative[b] + contents[b];
+
+        double width = ( fEdges[nbins] - fEdges[0] ) / nbins;
+        fUniform = true;
+        for( int b = 0; b <= nbins && fUniform; b++ )
+            fUniform = std::abs( fEdges[b] - ( fEdges[0] + b * width ) ) < 1e-9 * std::max( 1., width );
+        fScale = nbins / ( fEdges[nbins] - fEdges[0] );
+    }
+
+    int    GetNbins()          const { return fNbins; }
+    double GetContent( int b ) const { return fCumulative[b+1] - fCumulative[b]; }
+    double GetCenter ( int b ) const { return 0.5 * ( fEdges[b] + fEdges[b+1] ); }
+
+    // bin index (0 based) containing energy, clamped to the histogram range
+    int FindBin( double energy ) const
+    {
+        int b;
+        if( fUniform ) b = (int)( ( energy - fEdges[0] ) * fScale );
+        else           b = std::upper_bound( fEdges.begin(), fEdges.end(), energy ) - fEdges.begin() - 1;
+        return std::min( std::max( b, 0 ), fNbins-1 );
+    }
+
+    // counts in [elo, ehi], partial bins at the window edges are taken proportionally
+    double Integral( double elo, double ehi ) const
+    {
+        elo = std::max( elo, fEdges[0] ); ehi = std::min( ehi, fEdges[fNbins] );
+        if( ehi <= elo ) return 0.;
+        return Cumulative( ehi ) - Cumulative( elo );
+    }
+
+    // counts in bins blo..bhi (0 based, inclusive)
+    double IntegralBins( int blo, int bhi ) const { return fCumulative[bhi+1] - fCumulative[blo]; }
+
+  private:
+    // counts below energy
+    double Cumulative( double energy ) const
+    {
+        int b = FindBin( energy );
+        double frac = ( energy - fEdges[b] ) / ( fEdges[b+1] - fEdges[b] );
+        return fCumulative[b] + frac * GetContent(b);
+    }
+
+    int    fNbins;
+    bool   fUniform;
+    double fScale;
+    std::vector<double> fEdges;
+    std::vector<double> fCumulative;
+};
+
+// significant local maximum of a spectrum
+struct PeakCandidate
+{
+    int    bin;      // 0 based
+    double position; // keV, center of the maximum bin of the running mean
+    double fwhm;     // keV, of the running mean
+    double counts;   // in the bins above half maximum
+};
+
+// local maxima in [elo, ehi] of the running mean over 2*smoothing+1 bins that fall below
+// half of their height on both sides before any higher bin and inside [elo, ehi], and
+// whose counts above half maximum exceed the level of the side bands next to them by
+// significance standard deviations; a broad peak yields one candidate, fluctuations on
+// its flanks or in a tail none
+inline std::vector<PeakCandidate> FindPeakCandidates( const PrefixSum & spectrum, double elo, double ehi, double significance,
+                                                       int smoothing = 2 )
+{
+    std::vector<PeakCandidate> candidates;
+    int nbins = spectrum.GetNbins();
+    int blo = spectrum.FindBin( elo ), bhi = spectrum.FindBin( ehi );
+
+    // single bin fluctuations neither make nor split a peak in the running mean
+    auto content = [&]( int b )
+    {
+        int lo = std::max( b - smoothing, 0 ), hi = std::min( b + smoothing, nbins-1 );
+        return spectrum.IntegralBins( lo, hi ) / ( hi - lo + 1 );
+    };
+
+    for( int b = blo+1; b < bhi; b++ )
+    {
+        double height = content(b);
+        if( height <= 0. || height <= content(b-1) || height < content(b+1) ) continue;
+
+        // half maximum crossings, a higher bin on the way means b is on a flank
+        double half = 0.5 * height;
+        int bl = b, br = b;
+        bool flank = false;
+        while( bl > blo && content(bl-1) > half ) { bl--; flank |= content(bl) > height; }
+        while( br < bhi && content(br+1) > half ) { br++; flank |= content(br) > height; }
+        if( flank || bl == blo || br == bhi ) continue;
+
+        // level of the side bands as wide as the peak, the higher one counts
+        int width = br - bl + 1;
+        int ll = std::max( bl - width, 0 ), rr = std::min( br + width, nbins-1 );
+        double left  = bl > ll ? spectrum.IntegralBins( ll, bl-1 ) / ( bl - ll ) : 0.;
+        double right = rr > br ? spectrum.IntegralBins( br+1, rr ) / ( rr - br ) : 0.;
+        double sum   = spectrum.IntegralBins( bl, br );
+        if( sum - width * std::max( left, right ) <= significance * std::sqrt( sum ) ) continue;
+
+        auto crossing = [&]( int inside, int outside )
+        {
+            double ci = content(inside), co = content(outside);
+            double frac = ci > co ? ( ci - half ) / ( ci - co ) : 0.5;
+            return spectrum.GetCenter(inside) + frac * ( spectrum.GetCenter(outside) - spectrum.GetCenter(inside) );
+        };
+        double fwhm = std::max( crossing( br, br+1 ) - crossing( bl, bl-1 ), spectrum.GetCenter(b) - spectrum.GetCenter(b-1) );
+
+        // equal maxima of one peak: the first one is kept
+        if( !candidates.empty() && candidates.back().bin >= bl ) continue;
+        candidates.push_back( { b, spectrum.GetCenter(b), fwhm, sum } );
+        b = br;
+    }
+    return candidates;
+}
+
+// position, width and low energy tail of every alpha line. A dead layer shifts all
+// lines down by about the same energy loss, so the peaks are assigned together: every
+// pairing of a line with a significant local maximum proposes a common shift in
+// [-above, below] keV, each line takes the largest unassigned maximum within above keV
+// of its shifted energy, and the shift matching the most lines wins (then the most
+// counts, then the smallest shift). Lines without a peak are reported as not found.
+inline std::vector<PeakInfo> FindAlphaPeaks( const PrefixSum & spectrum, double below = 300., double above = 50., double tailwindow = 500.,
+                                             double significance = 5. )
+{
+    std::vector<PeakCandidate> candidates = FindPeakCandidates( spectrum, kAlphaLines.front().energy - below - above,
+                                                                kAlphaLines.back().energy + above, significance );
+
+    // candidate index per line (-1 none) for a shift, returns the number of lines matched
+    auto assign = [&]( double shift, std::vector<int> & match, double & counts )
+    {
+        match.assign( kAlphaLines.size(), -1 );
+        std::vector<bool> used( candidates.size(), false );
+        int nmatched = 0;
+        counts = 0.;
+        for( size_t l = 0; l < kAlphaLines.size(); l++ )
+        {
+            double expected = kAlphaLines[l].energy - shift;
+            for( size_t c = 0; c < candidates.size(); c++ )
+                if( !used[c] && std::abs( candidates[c].position - expected ) <= above &&
+                    ( match[l] < 0 || candidates[c].counts > candidates[match[l]].counts ) ) match[l] = c;
+            if( match[l] < 0 ) continue;
+            used[match[l]] = true;
+            counts += candidates[match[l]].counts;
+            nmatched++;
+        }
+        return nmatched;
+    };
+
+    std::vector<int> best( kAlphaLines.size(), -1 ), match;
+    int bestn = 0;
+    double bestcounts = 0., bestshift = 0.;
+    for( auto & line : kAlphaLines )
+    {
+        for( auto & candidate : candidates )
+        {
+            double shift = line.energy - candidate.position, counts;
+            if( shift < -above || shift > below ) continue;
+            int n = assign( shift, match, counts );
+            if( n > bestn || ( n == bestn && ( counts > bestcounts || ( counts == bestcounts && std::abs(shift) < std::abs(bestshift) ) ) ) )
+            {
+                best = match; bestn = n; bestcounts = counts; bestshift = shift;
+            }
+        }
+    }
+
+    std::vector<PeakInfo> peaks;
+    for( size_t l = 0; l < kAlphaLines.size(); l++ )
+    {
+        PeakInfo peak;
+        peak.line = kAlphaLines[l].name;
+        if( best[l] >= 0 )
+        {
+            const PeakCandidate & candidate = candidates[best[l]];
+            peak.found    = true;
+            peak.position = candidate.position;
+            peak.shift    = kAlphaLines[l].energy - candidate.position;
+            peak.fwhm     = candidate.fwhm;
+            peak.counts   = spectrum.Integral( peak.position - peak.fwhm, peak.position + peak.fwhm );
+            double tail   = spectrum.Integral( peak.position - tailwindow, peak.position - peak.fwhm );
+            peak.tail     = tail + peak.counts > 0. ? tail / ( tail + peak.counts ) : 0.;
+        }
+        peaks.push_back( peak );
+    }
+    return peaks;
+}
+
+#endif
@@ -0,0 +1,269 @@
+/*
+ * Author      : spectra-utils contributors
+ * Date        : 18.10.2026
+ * Note        : deterministic synthetic inputs for all tools, to profile and
+ *               regression test them without gerda-mage-sim and gerda-bkg-model
+ *               outputs. Every file has its own seed derived from --seed and the
+ *               file index, so a file does not change when the scale changes.
+ * Compilation : g++ -O3 -std=c++1y $(root-config --cflags) SyntheticDataGenerator.cxx $(root-config --libs) -o SyntheticDataGenerator
+*/
+
+
+// c/c++
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+
+// root cern
+#include "TFile.h"
+#include "TH1D.h"
+#include "TRandom3.h"
+#include "TSystem.h"
+
+// spectra-utils
+#include "OptionParser.h"
+#include "OutputFile.h"
+
+using namespace std;
+
+// simulated alpha source: isotope with the lines of its decay chain in keV
+struct AlphaSource
+{
+    string         isotope;
+    vector<double> lines;
+};
+
+const vector<AlphaSource> kSources =
+{
+    { "Po210", { 5304.3 } },
+    { "Ra226", { 4784.3, 5489.5, 6002.4, 7686.8 } },
+    { "Rn222", { 5489.5, 6002.4, 7686.8 } }
+};
+const vector<string> kLocations = { "pPlus", "LAr" };
+
+OptionParser MakeParser();
+int Run( const Options & opts );
+void FillAlphaSpectrum( TH1D & h, const AlphaSource & source, double deadlayer, long events, TRandom3 & rnd );
+bool WriteAlphaFiles( string dir, const Options & opts, int compression );
+bool WriteFitFiles( string dir, const Options & opts, int compression );
+bool WritePdfFiles( string dir, const Options & opts, int compression );
+ULong_t FileSeed( int seed, int group, int index );
+
+int main( int argc, char* argv[] )
+{
+    // get command line arguments, one job per parameter set
+    OptionParser parser = MakeParser();
+    vector<Options> jobs;
+    int status = parser.ParseCommandLine( argc, argv, jobs );
+    if( status != 0 ) return status == OptionParser::kDone ? 0 : 1;
+
+    return RunJobs( jobs, Run );
+}
+
+int Run( const Options & opts )
+{
+    string dir = opts.Get("--output-dir");
+    if( dir.back() != '/' ) dir += "/";
+    gSystem->mkdir( dir.c_str(), true );
+
+    int compression;
+    if( !GetCompression( opts, compression ) ) return 1;
+
+    cout << "Writing synthetic data to " << dir << endl;
+    if( !WriteAlphaFiles( dir, opts, compression ) ) return 1;
+    if( !WriteFitFiles  ( dir, opts, compression ) ) return 1;
+    if( !WritePdfFiles  ( dir, opts, compression ) ) return 1;
+
+    return 0;
+}
+
+// surface alpha: an alpha emitted into the detector at cos(theta) = u crosses
+// deadlayer/u of dead layer and loses kStopping keV/nm there, resolution 3 keV
+void FillAlphaSpectrum( TH1D & h, const AlphaSource & source, double deadlayer, long events, TRandom3 & rnd )
+{
+    const double kStopping  = 0.15; // keV/nm
+    const double kSigma     = 3.;   // keV
+
+    for( long e = 0; e < events; e++ )
+    {
+        double line = source.lines[ rnd.Integer( source.lines.size() ) ];
+        double u = 1. - rnd.Rndm(); // (0,1]
+        double energy = line - kStopping * deadlayer / u;
+        if( energy <= 0. ) continue;
+        h.Fill( rnd.Gaus( energy, kSigma ) );
+    }
+}
+
+// <dir>/alpha/<isotope>-<location>-<index>.root with hist_dl0nm ... hist_dl1000nm,
+// plus a list file per isotope and location for HistogramCombiner --input-list
+bool WriteAlphaFiles( string dir, const Options & opts, int compression )
+{
+    int nfiles  = opts.GetInt("--alpha-files");
+    long events = opts.GetInt("--events");
+    int seed    = opts.GetInt("--seed");
+
+    string subdir = dir + "alpha/";
+    gSystem->mkdir( subdir.c_str(), true );
+
+    int group = 0;
+    for( auto & source : kSources )
+    {
+        for( auto & location : kLocations )
+        {
+            string listname = dir + "alpha-" + source.isotope + "-" + location + ".txt";
+            ofstream oflist( listname );
+
+            for( int i = 0; i < nfiles; i++ )
+            {
+                string filename = subdir + source.isotope + "-" + location + "-" + to_string(i) + ".root";
+                TRandom3 rnd( FileSeed( seed, group, i ) );
+
+                TFile file( filename.c_str(), "RECREATE" );
+                if( !file.IsOpen() ) { cout << "Cannot open output: " << filename << endl; return false; }
+                SetCompression( file, compression );
+                for( int dl = 0; dl <= 1000; dl += 100 )
+                {
+                    string hname = "hist_dl"; hname += to_string(dl); hname += "nm";
+                    TH1D h( hname.c_str(), hname.c_str(), 8000, 0., 8000. );
+                    h.SetDirectory( nullptr );
+                    FillAlphaSpectrum( h, source, dl, events, rnd );
+                    file.cd();
+                    h.Write();
+                }
+                file.Close();
+                oflist << filename << "\n";
+            }
+            cout << "\t" << nfiles << " alpha files, list " << listname << endl;
+            group++;
+        }
+    }
+    return true;
+}
+
+// <dir>/fit/fit-<index>.root in the gerda-bkg-model layout: results_canvas with
+// hSum_fine_ (data) and hMC_fine_ (model), components with the model components
+bool WriteFitFiles( string dir, const Options & opts, int compression )
+{
+    int nfiles  = opts.GetInt("--fit-files");
+    long events = opts.GetInt("--events");
+    int seed    = opts.GetInt("--seed");
+
+    string subdir = dir + "fit/";
+    gSystem->mkdir( subdir.c_str(), true );
+
+    for( int i = 0; i < nfiles; i++ )
+    {
+        string filename = subdir + "fit-" + to_string(i) + ".root";
+        TRandom3 rnd( FileSeed( seed, 100, i ) );
+
+        // model components, dead layers and normalisations vary between fits
+        vector<TH1D> comps;
+        int c = 0;
+        for( auto & source : kSources )
+        {
+            int dl = 100 * rnd.Integer( 11 );
+            string cname = source.isotope + "_pPlus_dl" + to_string(dl) + "nm_p0c" + to_string(c++) + "_fine_alpha";
+            TH1D h( cname.c_str(), cname.c_str(), 8000, 0., 8000. );
+            h.SetDirectory( nullptr );
+            FillAlphaSpectrum( h, source, dl, events, rnd );
+            h.Scale( rnd.Uniform( 0.05, 0.5 ) );
+            comps.push_back( h );
+        }
+        TH1D offset( "offset_p1c0_fine_alpha", "offset_p1c0_fine_alpha", 8000, 0., 8000. );
+        TH1D slope ( "slope_p1c1_fine_alpha",  "slope_p1c1_fine_alpha",  8000, 0., 8000. );
+        offset.SetDirectory( nullptr ); slope.SetDirectory( nullptr );
+        for( int b = 3500; b <= 8000; b++ )
+        {
+            offset.SetBinContent( b, 2e-3 );
+            slope .SetBinContent( b, 1e-3 * b / 8000. );
+        }
+        comps.push_back( offset );
+        comps.push_back( slope );
+
+        // model is the sum of the components, data a poisson fluctuation of it
+        TH1D hmc( "hMC_fine_alpha", "hMC_fine_alpha", 8000, 0., 8000. );
+        TH1D hsum( "hSum_fine_alpha", "hSum_fine_alpha", 8000, 0., 8000. );
+        hmc.SetDirectory( nullptr ); hsum.SetDirectory( nullptr );
+        for( auto & h : comps ) hmc.Add( &h );
+        for( int b = 1; b <= 8000; b++ ) hsum.SetBinContent( b, rnd.Poisson( hmc.GetBinContent(b) ) );
+
+        TFile file( filename.c_str(), "RECREATE" );
+        if( !file.IsOpen() ) { cout << "Cannot open output: " << filename << endl; return false; }
+        SetCompression( file, compression );
+        file.mkdir( "results_canvas" )->cd();
+        hsum.Write(); hmc.Write();
+        file.mkdir( "components" )->cd();
+        for( auto & h : comps ) h.Write();
+        file.Close();
+    }
+    cout << "\t" << nfiles << " fit files in " << subdir << endl;
+    return true;
+}
+
+// <dir>/pdf/pdf-<volume>-<part>-<isotope>.root with a channel resolved histogram
+// (one bin per detector, bin 7 is the unused channel) and the file list for OplotBKGSpectra
+bool WritePdfFiles( string dir, const Options & opts, int compression )
+{
+    int nfiles  = opts.GetInt("--pdf-files");
+    long events = opts.GetInt("--events");
+    int seed    = opts.GetInt("--seed");
+    string hname = opts.Get("--pdf-histo");
+
+    const vector<string> isotopes = { "K40", "K42", "Co60", "Bi212", "Bi214", "Tl208", "Ac228", "Pb214" };
+    const vector<string> volumes  = { "gedet-surf", "gedet-bulk", "larveto-fibers", "minishroud-nylon", "cables-signal", "holders-copper" };
+
+    string subdir = dir + "pdf/";
+    gSystem->mkdir( subdir.c_str(), true );
+    string listname = dir + "pdf-list.txt";
+    ofstream oflist( listname );
+    oflist << subdir << "\n";
+
+    for( int i = 0; i < nfiles; i++ )
+    {
+        string volume  = volumes [ i % volumes.size() ];
+        string isotope = isotopes[ (i / volumes.size()) % isotopes.size() ];
+        string suffix  = i < (int)(volumes.size() * isotopes.size()) ? "" : to_string( i / (volumes.size() * isotopes.size()) );
+        string filename = "pdf-" + volume + suffix + "-" + isotope + ".root";
+        TRandom3 rnd( FileSeed( seed, 200, i ) );
+
+        TH1D h( hname.c_str(), hname.c_str(), 40, 0., 40. );
+        h.SetDirectory( nullptr );
+        for( int b = 1; b <= 40; b++ )
+        {
+            if( b == 7 ) continue;
+            h.SetBinContent( b, rnd.Poisson( events / 40. * rnd.Exp( 1. ) ) );
+        }
+
+        TFile file( (subdir + filename).c_str(), "RECREATE" );
+        if( !file.IsOpen() ) { cout << "Cannot open output: " << subdir << filename << endl; return false; }
+        SetCompression( file, compression );
+        h.Write();
+        file.Close();
+        oflist << filename << "\n";
+    }
+    cout << "\t" << nfiles << " pdf files, list " << listname << endl;
+    return true;
+}
+
+// independent random sequence per file
+ULong_t FileSeed( int seed, int group, int index )
+{
+    return 1000003UL * ( 1000UL * seed + group ) + index + 1;
+}
+
+OptionParser MakeParser()
+{
+    OptionParser parser( "SyntheticDataGenerator", "Write deterministic synthetic inputs for all tools" );
+    parser.AddExample( "--output-dir synthetic --alpha-files 100 --events 100000" );
+    parser.AddOption( "--output-dir",  "-o", OptionParser::kString, "<dir>",  "output directory", "synthetic" );
+    parser.AddOption( "--seed",        "-s", OptionParser::kInt,    "<int>",  "random seed", "1" );
+    parser.AddOption( "--alpha-files", "",   OptionParser::kInt,    "<int>",  "alpha simulation files per isotope and location", "10" );
+    parser.AddOption( "--fit-files",   "",   OptionParser::kInt,    "<int>",  "alpha fit output files", "5" );
+    parser.AddOption( "--pdf-files",   "",   OptionParser::kInt,    "<int>",  "channel resolved pdf files", "20" );
+    parser.AddOption( "--events",      "-n", OptionParser::kInt,    "<int>",  "events per histogram", "10000" );
+    parser.AddOption( "--pdf-histo",   "",   OptionParser::kString, "<name>", "name of the channel resolved histogram", "M1_enrE1plusE2" );
+    AddCompressionOption( parser );
+    return parser;
+}
@@ -0,0 +1,223 @@
+#!/bin/bash
+#
+# Author      : spectra-utils contributors
+# Date        : 18.10.2026
+# Note        : golden output regression check of all tools. Generates the synthetic
+#               corpus with a fixed seed and runs every tool on it.
+#               - self checks, no reference needed: the plain HistogramCombiner a.root
+#                 b.root out.root of the original tool against the sum of hadd, and
+#                 the chunked, map/reduce (--chunk-index) and watch mode merges
+#                 against the flat merge, all bin by bin and exact
+#               - reference checks: root outputs with HistogramDiff, tables and the
+#                 columnar tree dump with diff against the references in tests/golden,
+#                 or with --reference against the outputs of another build on the
+#                 same corpus
+#               --update records tests/golden with this build and its version in
+#               tests/golden/BUILD, rebuild that commit to compare with --reference.
+# Usage       : tests/golden.sh [--update | --reference <refbindir>] [<bindir>]
+#               (bindir default: repo root)
+#
+
+set -u
+
+tests=$(cd "$(dirname "$0")" && pwd)
+repo="$(dirname "$tests")"
+golden="$tests/golden"
+bin="$repo"
+reference=""
+
+update=0
+while [ $# -gt 0 ]; do
+    case "$1" in
+        --update)    update=1 ;;
+        --reference) shift; reference=$(cd "${1:-}" && pwd) || exit 1 ;;
+        -h|--help)   sed -n '2,18p' "$0"; exit 0 ;;
+        *)           bin=$(cd "$1" && pwd) || exit 1 ;;
+    esac
+    shift
+done
+if [ "$update" = 1 ] && [ -n "$reference" ]; then echo "--update and --reference exclude each other"; exit 1; fi
+
+tools="SyntheticDataGenerator HistogramCombiner HistogramDiff AlphaPlotter AlphaPeakFinder BackgroundAlphaPlotter OplotBKGSpectra"
+for dir in "$bin" $reference; do
+    for tool in $tools; do
+        if [ ! -x "$dir/$tool" ]; then echo "Tool not Found: $dir/$tool (compile it or give <bindir>)"; exit 1; fi
+    done
+done
+
+# hadd and root of the root installation the tools are built with
+rootbin=$(root-config --bindir 2>/dev/null)
+for tool in hadd root; do
+    if [ ! -x "$rootbin/$tool" ]; then echo "Tool not Found: $tool (root-config --bindir)"; exit 1; fi
+done
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+log="$work/log.txt"
+
+failed=0
+
+# runs a tool of build $tooldir, its output goes to the log
+run()
+{
+    echo "+ $*" >> "$log"
+    if ! "$tooldir/$@" >> "$log" 2>&1; then
+        echo "FAIL  $*"
+        tail -n 20 "$log"
+        exit 1
+    fi
+}
+
+# bin by bin comparison of two root files of this run, relative tolerance $3
+same()
+{
+    local a=$1 b=$2 tolerance=${3:-0}
+    echo "+ HistogramDiff --tolerance $tolerance $a $b" >> "$log"
+    if "$bin/HistogramDiff" --tolerance "$tolerance" "$a" "$b" >> "$log" 2>&1; then echo "OK    $b"; else echo "FAIL  $b differs from $a"; failed=$((failed+1)); fi
+}
+
+# count, entries and sums of every row of the columnar tree $1 as table $2
+dump_columnar()
+{
+    echo "+ root scan of $1" >> "$log"
+    "$rootbin/root" -l -b -q -e "TFile f(\"$1\"); TTree * t = (TTree*)f.Get(\"spectra\"); if( !t ) gSystem->Exit(1);
+        t->SetScanField(0); t->Scan(\"name:isotope:location:dead_layer_nm:entries:nbins:Sum\$(content):Sum\$(error*error)\", \"\", \"colsize=24 precision=17\");" \
+        > "$2" 2>> "$log" || { echo "FAIL  cannot read the columnar tree of $1"; exit 1; }
+}
+
+# outputs compared with the references, produced by build $tooldir in the current
+# directory from the corpus in ../synthetic
+outputs()
+{
+    ln -s ../synthetic synthetic
+
+    # HistogramCombiner flat merge, convergence status and columnar export
+    for isotope in Po210 Ra226 Rn222; do
+        for location in pPlus LAr; do
+            run HistogramCombiner --input-list "synthetic/alpha-$isotope-$location.txt" "sum-$isotope-$location.root"
+        done
+    done
+    run HistogramCombiner --input-list synthetic/alpha-Po210-pPlus.txt --conv-target 0.05 --conv-window 5200:5350 \
+        --conv-output convergence-Po210-pPlus.txt converged-Po210-pPlus.root
+    run HistogramCombiner --input-list synthetic/alpha-Rn222-LAr.txt --columnar columnar-Rn222-LAr.root \
+        --isotope Rn222 --location LAr columnar-sum-Rn222-LAr.root
+    dump_columnar columnar-Rn222-LAr.root columnar-Rn222-LAr.txt
+
+    # AlphaPlotter with interpolated dead layers, plot-<isotope><location>.root
+    run AlphaPlotter --input sum-Po210-pPlus.root --dead-layer 150,450 --interpolation morph
+
+    # AlphaPeakFinder tables
+    run AlphaPeakFinder --peaks --output peaks.txt sum-Po210-pPlus.root sum-Ra226-pPlus.root sum-Rn222-LAr.root
+
+    # BackgroundAlphaPlotter plot of one fit and goodness of fit scan of all fits
+    run BackgroundAlphaPlotter --input synthetic/fit/fit-0.root --output background-fit-0.root
+    ls synthetic/fit/*.root > fit-list.txt
+    run BackgroundAlphaPlotter --scan --input fit-list.txt --output scan.txt --scan-binnings 1,10 --threads 2
+
+    # OplotBKGSpectra of the channel resolved pdfs with sums over the detector types
+    run OplotBKGSpectra --input synthetic/pdf-list.txt --histo M1_enrE1plusE2 --output oplot --groups type --threads 2
+}
+
+# compares output file $1 with its reference, root files with HistogramDiff and
+# relative tolerance $2, other files line by line
+check()
+{
+    local file=$1 tolerance=${2:-0}
+    if [ "$update" = 1 ]; then
+        cp "$file" "$golden/$file"
+        echo "SAVED $file"
+        return
+    fi
+    if [ ! -f "$golden/$file" ]; then
+        echo "FAIL  $file: no reference, record with tests/golden.sh --update"
+        failed=$((failed+1))
+        return
+    fi
+    case "$file" in
+        *.root) "$bin/HistogramDiff" --tolerance "$tolerance" "$golden/$file" "$file" >> "$log" 2>&1 ;;
+        *)      diff -u "$golden/$file" "$file" >> "$log" 2>&1 ;;
+    esac
+    if [ $? -eq 0 ]; then echo "OK    $file"; else echo "FAIL  $file"; failed=$((failed+1)); fi
+}
+
+# corpus, small enough to run in a few seconds
+cd "$work"
+tooldir="$bin"
+run SyntheticDataGenerator --output-dir synthetic --seed 1 --alpha-files 4 --fit-files 3 --pdf-files 12 --events 2000
+
+mkdir "$work/outputs" && cd "$work/outputs"
+outputs
+
+# plain positional merge of the original HistogramCombiner against hadd
+a=$(sed -n 1p synthetic/alpha-Ra226-pPlus.txt)
+b=$(sed -n 2p synthetic/alpha-Ra226-pPlus.txt)
+run HistogramCombiner "$a" "$b" plain-sum.root
+echo "+ hadd hadd-sum.root $a $b" >> "$log"
+"$rootbin/hadd" -f hadd-sum.root "$a" "$b" >> "$log" 2>&1 || { echo "FAIL  hadd"; exit 1; }
+same hadd-sum.root plain-sum.root
+
+# chunked merge on several threads, map stage per chunk with reduce of the partial
+# sums, and watch mode have to agree bit for bit with the flat merge (unweighted inputs)
+for isotope in Po210 Ra226 Rn222; do
+    for location in pPlus LAr; do
+        run HistogramCombiner --input-list "synthetic/alpha-$isotope-$location.txt" --chunk-size 2 --threads 3 "chunked-$isotope-$location.root"
+        same "sum-$isotope-$location.root" "chunked-$isotope-$location.root"
+    done
+done
+
+for k in 0 1; do
+    run HistogramCombiner --input-list synthetic/alpha-Po210-LAr.txt --chunk-size 2 --chunk-index $k "partial-$k.root"
+done
+run HistogramCombiner partial-0.root partial-1.root reduced-Po210-LAr.root
+same sum-Po210-LAr.root reduced-Po210-LAr.root
+
+# the first input is merged, the others are copied into the watched directory once
+# the first output is written, i.e. once the directory is watched
+mkdir incoming
+inputs=( $(cat synthetic/alpha-Rn222-pPlus.txt) )
+echo "+ HistogramCombiner --watch incoming ${inputs[0]} watched-Rn222-pPlus.root" >> "$log"
+"$bin/HistogramCombiner" --watch incoming --interval 0 --watch-timeout 5 "${inputs[0]}" watched-Rn222-pPlus.root >> "$log" 2>&1 &
+watcher=$!
+for i in $(seq 300); do
+    if [ -f watched-Rn222-pPlus.root ] || ! kill -0 $watcher 2>/dev/null; then break; fi
+    sleep 0.1
+done
+for input in "${inputs[@]:1}"; do cp "$input" incoming/; done
+if wait $watcher; then same sum-Rn222-pPlus.root watched-Rn222-pPlus.root; else echo "FAIL  watch mode"; failed=$((failed+1)); fi
+
+# references: tests/golden, or the outputs of the reference build
+if [ -n "$reference" ]; then
+    golden="$work/reference"
+    mkdir "$golden" && cd "$golden"
+    tooldir="$reference"
+    outputs
+    cd "$work/outputs"
+elif [ "$update" = 1 ]; then
+    rm -rf "$golden" && mkdir -p "$golden"
+    {
+        echo "commit $(git -C "$repo" describe --always --dirty 2>/dev/null)"
+        echo "root   $(root-config --version)"
+        echo "c++    $(c++ --version | head -n 1)"
+    } > "$golden/BUILD"
+elif [ -f "$golden/BUILD" ]; then
+    echo "References of"; sed 's/^/    /' "$golden/BUILD"
+fi
+
+for isotope in Po210 Ra226 Rn222; do
+    for location in pPlus LAr; do
+        check "sum-$isotope-$location.root"
+    done
+done
+check convergence-Po210-pPlus.txt
+check columnar-Rn222-LAr.txt
+check plot-Po210pPlus.root 1e-9
+check peaks.txt
+check background-fit-0.root 1e-9
+check scan.txt
+check oplot.root
+check oplot-groups.txt
+
+if [ "$update" = 1 ]; then echo "References written to $golden"; fi
+if [ "$failed" -gt 0 ]; then echo "$failed outputs differ, log:"; cat "$log"; exit 1; fi
+if [ "$update" = 0 ]; then echo "All outputs agree with the references"; fi
+exit 0